@@ -2,7 +2,7 @@
 #include <numeric>
 
 namespace gameboy::apu {
-    Core::Core(std::reference_wrapper<ui::AudioDevice> device_ref) : device{device_ref}
+    Core::Core()
     {
         sample_buffer.reserve(4096);
     }
@@ -15,7 +15,7 @@ namespace gameboy::apu {
     void Core::idle(Psg& generator)
     {
         if (generator.is_enabled()) {
-            operation = work;
+            operation = &Core::work;
             operation(this, generator);
         }
     }
@@ -23,10 +23,9 @@ namespace gameboy::apu {
     void Core::work(Psg& generator)
     {
         static constexpr auto cycles_per_frame{44};
-        static int cycle{0};
 
         if (!generator.is_enabled()) {
-            operation = idle;
+            operation = &Core::idle;
             return;
         }
 
@@ -37,10 +36,28 @@ namespace gameboy::apu {
             sample_buffer.push_back(sample.right);
             cycle = 0;
         }
+    }
 
-        if (sample_buffer.size() == 4096) {
-            ui::play_sound(device.get().get_id(), sample_buffer);
-            sample_buffer.clear();
-        }
+    std::span<const float> Core::get_samples() const
+    {
+        return sample_buffer;
+    }
+
+    void Core::clear_samples()
+    {
+        sample_buffer.clear();
+    }
+
+    // The samples are the output of the current run rather than a part of the hardware, so they aren't saved.
+    void Core::save(state::Writer& out) const
+    {
+        out.write(*operation.target<void (Core::*)(Psg&)>() == &Core::work);
+        out.write(cycle);
+    }
+
+    void Core::load(state::Reader& in)
+    {
+        operation = in.read<bool>() ? &Core::work : &Core::idle;
+        cycle = in.read<int>();
     }
 }
\ No newline at end of file
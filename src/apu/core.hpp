@@ -2,24 +2,29 @@
 #define APU_CORE_H
 
 #include <functional>
+#include <span>
 #include <vector>
 #include "psg.hpp"
+#include "state.hpp"
 #include "timer.hpp"
-#include "ui/sound.hpp"
 
 namespace gameboy::apu {
     class Core {
     public:
-        explicit Core(std::reference_wrapper<ui::AudioDevice> device_ref);
+        explicit Core();
         void tick(Psg& generator);
+        std::span<const float> get_samples() const;
+        void clear_samples();
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
     private:
         void idle(Psg& generator);
         void work(Psg& generator);
 
         std::function<void(Core*, Psg&)> operation{&Core::idle};
 
+        int cycle{};
         std::vector<float> sample_buffer{};
-        std::reference_wrapper<ui::AudioDevice> device;
     };
 }
 
@@ -1,6 +1,5 @@
 #include "psg.hpp"
 #include <algorithm>
-#include <stdexcept>
 
 namespace gameboy::apu {
     int get_frequency_data(const SquareWave& regs)
@@ -351,156 +350,237 @@ namespace gameboy::apu {
         frame_sequencer = (frame_sequencer + 1) % 8;
     }
 
-    std::uint8_t Psg::read(int address) const
+    void Psg::save(state::Writer& out) const
     {
-        if (address >= 0xFF30) {
-            return is_enabled() ? wave_pattern[address - 0xFF30] : static_cast<std::uint8_t>(channel3.volume);
-        }
-
-        switch (address) {
-            case 0xFF10:
-                return channel1.regs.nr_0;
-            case 0xFF11:
-                return channel1.regs.nr_1 | 0b00111111;
-            case 0xFF12:
-                return channel1.regs.nr_2;
-            case 0xFF14:
-                return channel1.regs.nr_4 | 0b10111111;
-            case 0xFF16:
-                return channel2.regs.nr_1 | 0b00111111;
-            case 0xFF17:
-                return channel2.regs.nr_2;
-            case 0xFF19:
-                return channel2.regs.nr_4 | 0b10111111;
-            case 0xFF1A:
-                return channel3.regs.nr_0;
-            case 0xFF1C:
-                return channel3.regs.nr_2;
-            case 0xFF1E:
-                return channel3.regs.nr_4 | 0b10111111;
-            case 0xFF21:
-                return channel4.regs.nr_2;
-            case 0xFF22:
-                return channel4.regs.nr_3;
-            case 0xFF23:
-                return channel4.regs.nr_4 | 0b10111111;
-            case 0xFF24:
-                return regs.volume;
-            case 0xFF25:
-                return regs.panning;
-            case 0xFF26:
-                return regs.control | 0b10000000;
-            default:
-                return 0xFF;
-        };
+        out.write(frame_sequencer);
+
+        out.write(channel1.regs);
+        out.write(channel1.sweep_counter);
+        out.write(channel1.length_counter);
+        out.write(channel1.envelope_counter);
+        out.write(channel1.frequency_counter);
+        out.write(channel1.sequence_position);
+        out.write(channel1.volume);
+        out.write(channel1.shadow_frequency);
+        out.write(channel1.sweep_enabled);
+
+        out.write(channel2.regs);
+        out.write(channel2.length_counter);
+        out.write(channel2.envelope_counter);
+        out.write(channel2.frequency_counter);
+        out.write(channel2.sequence_position);
+        out.write(channel2.volume);
+
+        out.write(channel3.regs);
+        out.write(channel3.length_counter);
+        out.write(channel3.frequency_counter);
+        out.write(channel3.sequence_position);
+        out.write(channel3.volume);
+
+        out.write(channel4.regs);
+        out.write(channel4.length_counter);
+        out.write(channel4.envelope_counter);
+        out.write(channel4.frequency_counter);
+        out.write(channel4.sequence_position);
+        out.write(channel4.volume);
+
+        out.write(regs);
+        out.write(wave_pattern);
     }
 
-    void Psg::write(int address, std::uint8_t value)
+    void Psg::load(state::Reader& in)
     {
-        if (address >= 0xFF30) {
-            wave_pattern[address - 0xFF30] = value;
-            return;
-        }
+        frame_sequencer = in.read<int>();
+
+        channel1.regs = in.read<SweepableSquareWave>();
+        channel1.sweep_counter = in.read<Timer>();
+        channel1.length_counter = in.read<Timer>();
+        channel1.envelope_counter = in.read<Timer>();
+        channel1.frequency_counter = in.read<Timer>();
+        channel1.sequence_position = in.read<int>();
+        channel1.volume = in.read<int>();
+        channel1.shadow_frequency = in.read<int>();
+        channel1.sweep_enabled = in.read<bool>();
+
+        channel2.regs = in.read<SquareWave>();
+        channel2.length_counter = in.read<Timer>();
+        channel2.envelope_counter = in.read<Timer>();
+        channel2.frequency_counter = in.read<Timer>();
+        channel2.sequence_position = in.read<int>();
+        channel2.volume = in.read<int>();
+
+        channel3.regs = in.read<CustomWave>();
+        channel3.length_counter = in.read<Timer>();
+        channel3.frequency_counter = in.read<Timer>();
+        channel3.sequence_position = in.read<int>();
+        channel3.volume = in.read<int>();
+
+        channel4.regs = in.read<Noise>();
+        channel4.length_counter = in.read<Timer>();
+        channel4.envelope_counter = in.read<Timer>();
+        channel4.frequency_counter = in.read<Timer>();
+        channel4.sequence_position = in.read<int>();
+        channel4.volume = in.read<int>();
+
+        regs = in.read<Registers>();
+        wave_pattern = in.read<decltype(wave_pattern)>();
+    }
 
-        // only the master control is mutable when disabled
-        if (!is_enabled() && address != 0xFF26) {
-            return;
+    template<int Address>
+    std::uint8_t Psg::read_port() const
+    {
+        if constexpr (Address >= 0xFF30) {
+            return is_enabled() ? wave_pattern[Address - 0xFF30] : static_cast<std::uint8_t>(channel3.volume);
+        }
+        else if constexpr (Address == 0xFF10) {
+            return channel1.regs.nr_0;
+        }
+        else if constexpr (Address == 0xFF11) {
+            return channel1.regs.nr_1 | 0b00111111;
+        }
+        else if constexpr (Address == 0xFF12) {
+            return channel1.regs.nr_2;
+        }
+        else if constexpr (Address == 0xFF14) {
+            return channel1.regs.nr_4 | 0b10111111;
+        }
+        else if constexpr (Address == 0xFF16) {
+            return channel2.regs.nr_1 | 0b00111111;
+        }
+        else if constexpr (Address == 0xFF17) {
+            return channel2.regs.nr_2;
+        }
+        else if constexpr (Address == 0xFF19) {
+            return channel2.regs.nr_4 | 0b10111111;
+        }
+        else if constexpr (Address == 0xFF1A) {
+            return channel3.regs.nr_0;
+        }
+        else if constexpr (Address == 0xFF1C) {
+            return channel3.regs.nr_2;
+        }
+        else if constexpr (Address == 0xFF1E) {
+            return channel3.regs.nr_4 | 0b10111111;
+        }
+        else if constexpr (Address == 0xFF21) {
+            return channel4.regs.nr_2;
+        }
+        else if constexpr (Address == 0xFF22) {
+            return channel4.regs.nr_3;
+        }
+        else if constexpr (Address == 0xFF23) {
+            return channel4.regs.nr_4 | 0b10111111;
         }
+        else if constexpr (Address == 0xFF24) {
+            return regs.volume;
+        }
+        else if constexpr (Address == 0xFF25) {
+            return regs.panning;
+        }
+        else if constexpr (Address == 0xFF26) {
+            return regs.control | 0b10000000;
+        }
+        else {
+            return 0xFF; // write-only or unused
+        }
+    }
 
-        switch (address) {
-            case 0xFF10:
-                channel1.regs.nr_0 = value | 0b10000000;
-                break;
-            case 0xFF11:
-                channel1.regs.nr_1 = value;
-                channel1.length_counter.reset(64 - channel1.regs.nr_1 % 64);
-                break;
-            case 0xFF12:
-                channel1.regs.nr_2 = value;
-                break;
-            case 0xFF13:
-                channel1.regs.nr_3 = value;
-                break;
-            case 0xFF14:
-                channel1.regs.nr_4 = value | 0b00111000;
-                break;
-            case 0xFF16:
-                channel2.regs.nr_1 = value;
-                channel2.length_counter.reset(64 - channel2.regs.nr_1 % 64);
-                break;
-            case 0xFF17:
-                channel2.regs.nr_2 = value;
-                break;
-            case 0xFF18:
-                channel2.regs.nr_3 = value;
-                break;
-            case 0xFF19:
-                channel2.regs.nr_4 = value | 0b00111000;
-                break;
-            case 0xFF1A:
-                channel3.regs.nr_0 = value | 0b01111111;
-                break;
-            case 0xFF1B:
-                channel3.regs.nr_1 = value;
-                channel3.length_counter.reset(256 - channel3.regs.nr_1 % 256);
-                break;
-            case 0xFF1C:
-                channel3.regs.nr_2 = value | 0b10011111;
-                break;
-            case 0xFF1D:
-                channel3.regs.nr_3 = value;
-                break;
-            case 0xFF1E:
-                channel3.regs.nr_4 = value | 0b00111000;
-                break;
-            case 0xFF20:
-                channel4.regs.nr_1 = value | 0b11000000;
-                channel4.length_counter.reset(64 - channel4.regs.nr_1 % 64);
-                break;
-            case 0xFF21:
-                channel4.regs.nr_2 = value;
-                break;
-            case 0xFF22:
-                channel4.regs.nr_3 = value;
-                break;
-            case 0xFF23:
-                channel4.regs.nr_4 = value | 0b00111111;
-                break;
-            case 0xFF24:
-                regs.volume = value;
-                break;
-            case 0xFF25:
-                regs.panning = value;
-                break;
-            case 0xFF26:
-                regs.control &= (value | 0b01111111);
-                if (!is_enabled()) {
-                    channel1.regs = {};
-                    channel2.regs = {};
-                    channel3.regs = {};
-                    channel4.regs = {};
-                    regs.volume = 0;
-                    regs.panning = 0;
-                }
-                else {
-                    frame_sequencer = 0;
-                    channel3.volume = 0;
-                }
-                break;
-            case 0xFF15:
-            case 0xFF1F:
-            case 0xFF27:
-            case 0xFF28:
-            case 0xFF29:
-            case 0xFF2A:
-            case 0xFF2B:
-            case 0xFF2C:
-            case 0xFF2D:
-            case 0xFF2E:
-            case 0xFF2F:
-                break;
-            default:
-                throw std::out_of_range{"Invalid address."};
+    template<int Address>
+    void Psg::write_port(std::uint8_t value)
+    {
+        if constexpr (Address >= 0xFF30) {
+            wave_pattern[Address - 0xFF30] = value;
+        }
+        else if (!is_enabled() && Address != 0xFF26) {
+            return; // only the master control is mutable when disabled
+        }
+        else if constexpr (Address == 0xFF10) {
+            channel1.regs.nr_0 = value | 0b10000000;
+        }
+        else if constexpr (Address == 0xFF11) {
+            channel1.regs.nr_1 = value;
+            channel1.length_counter.reset(64 - channel1.regs.nr_1 % 64);
+        }
+        else if constexpr (Address == 0xFF12) {
+            channel1.regs.nr_2 = value;
+        }
+        else if constexpr (Address == 0xFF13) {
+            channel1.regs.nr_3 = value;
+        }
+        else if constexpr (Address == 0xFF14) {
+            channel1.regs.nr_4 = value | 0b00111000;
+        }
+        else if constexpr (Address == 0xFF16) {
+            channel2.regs.nr_1 = value;
+            channel2.length_counter.reset(64 - channel2.regs.nr_1 % 64);
+        }
+        else if constexpr (Address == 0xFF17) {
+            channel2.regs.nr_2 = value;
+        }
+        else if constexpr (Address == 0xFF18) {
+            channel2.regs.nr_3 = value;
         }
+        else if constexpr (Address == 0xFF19) {
+            channel2.regs.nr_4 = value | 0b00111000;
+        }
+        else if constexpr (Address == 0xFF1A) {
+            channel3.regs.nr_0 = value | 0b01111111;
+        }
+        else if constexpr (Address == 0xFF1B) {
+            channel3.regs.nr_1 = value;
+            channel3.length_counter.reset(256 - channel3.regs.nr_1 % 256);
+        }
+        else if constexpr (Address == 0xFF1C) {
+            channel3.regs.nr_2 = value | 0b10011111;
+        }
+        else if constexpr (Address == 0xFF1D) {
+            channel3.regs.nr_3 = value;
+        }
+        else if constexpr (Address == 0xFF1E) {
+            channel3.regs.nr_4 = value | 0b00111000;
+        }
+        else if constexpr (Address == 0xFF20) {
+            channel4.regs.nr_1 = value | 0b11000000;
+            channel4.length_counter.reset(64 - channel4.regs.nr_1 % 64);
+        }
+        else if constexpr (Address == 0xFF21) {
+            channel4.regs.nr_2 = value;
+        }
+        else if constexpr (Address == 0xFF22) {
+            channel4.regs.nr_3 = value;
+        }
+        else if constexpr (Address == 0xFF23) {
+            channel4.regs.nr_4 = value | 0b00111111;
+        }
+        else if constexpr (Address == 0xFF24) {
+            regs.volume = value;
+        }
+        else if constexpr (Address == 0xFF25) {
+            regs.panning = value;
+        }
+        else if constexpr (Address == 0xFF26) {
+            regs.control &= (value | 0b01111111);
+            if (!is_enabled()) {
+                channel1.regs = {};
+                channel2.regs = {};
+                channel3.regs = {};
+                channel4.regs = {};
+                regs.volume = 0;
+                regs.panning = 0;
+            }
+            else {
+                frame_sequencer = 0;
+                channel3.volume = 0;
+            }
+        }
+        else {
+            // FF15, FF1F and FF27-FF2F are unused
+            static_assert(Address == 0xFF15 || Address == 0xFF1F || (Address >= 0xFF27 && Address < 0xFF30), "Invalid address.");
+        }
+    }
+
+    void Psg::map_ports(io::PortTable& table)
+    {
+        io::bind_ports<0xFF10, 0xFF3F>(table, *this, true);
     }
 }
\ No newline at end of file
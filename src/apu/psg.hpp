@@ -4,6 +4,7 @@
 #include <array>
 #include <cstdint>
 #include "io/port.hpp"
+#include "state.hpp"
 #include "timer.hpp"
 
 namespace gameboy::apu {
@@ -135,7 +136,7 @@ namespace gameboy::apu {
         float right;
     };
 
-    class Psg : public io::Port {
+    class Psg {
     public:
         bool is_enabled() const;
         Sample get_sample() const;
@@ -144,9 +145,13 @@ namespace gameboy::apu {
         void advance_sequencer(int divider);
 
         void update();
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
 
-        virtual std::uint8_t read(int address) const override;
-        virtual void write(int address, std::uint8_t value) override;
+        void map_ports(io::PortTable& table); // FF10-FF3F
+
+        template<int Address> std::uint8_t read_port() const;
+        template<int Address> void write_port(std::uint8_t value);
     private:
         struct Registers {
             /*
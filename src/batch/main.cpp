@@ -0,0 +1,75 @@
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "manifest.hpp"
+#include "pool.hpp"
+#include "runner.hpp"
+
+/*
+    Usage: gameboy-batch <manifest> <results> [--jobs N] [--fast] [--scanline] [--no-idle-skip]
+*/
+int main(int argc, char *argv[])
+{
+    using namespace gameboy;
+
+    static constexpr std::string_view usage{"Usage: gameboy-batch <manifest> <results> [--jobs N] [--fast] [--scanline] [--no-idle-skip]\n"};
+    if (argc < 3) {
+        std::cerr << usage;
+        return 1;
+    }
+
+    auto worker_count{std::thread::hardware_concurrency()};
+    auto mode{Machine::ExecutionMode::m_cycle};
+    auto renderer{ppu::Renderer::fifo};
+    auto is_idle_skipped{true};
+    for (auto i{3}; i < argc; ++i) {
+        std::string_view option{argv[i]};
+        if (option == "--fast") {
+            mode = Machine::ExecutionMode::instruction;
+        }
+        else if (option == "--scanline") {
+            renderer = ppu::Renderer::scanline;
+        }
+        else if (option == "--no-idle-skip") {
+            is_idle_skipped = false;
+        }
+        else if (option == "--jobs" && i + 1 < argc) {
+            std::string_view value{argv[++i]};
+            auto [end, error]{std::from_chars(value.data(), value.data() + value.size(), worker_count)};
+            if (error != std::errc{} || end != value.data() + value.size() || worker_count == 0) {
+                std::cerr << "Invalid number of jobs: " << value << "\n" << usage;
+                return 1;
+            }
+        }
+    }
+
+    try {
+        auto jobs{batch::read_manifest(argv[1])};
+        std::vector<batch::Result> results(jobs.size());
+
+        std::vector<batch::Pool::Task> tasks{};
+        for (std::size_t i{0}; i < jobs.size(); ++i) {
+            tasks.push_back([&jobs, &results, mode, renderer, is_idle_skipped, i]() {
+                results[i] = batch::run_job(jobs[i], mode, renderer, is_idle_skipped);
+            });
+        }
+
+        batch::Pool pool{worker_count};
+        pool.run(std::move(tasks));
+        batch::write_results(argv[2], results);
+
+        auto passed{std::count_if(results.cbegin(), results.cend(), [](const batch::Result& result) {
+            return result.status == batch::Result::Status::pass;
+        })};
+        std::cout << passed << " / " << results.size() << " passed\n";
+
+        return passed == std::ssize(results) ? 0 : 2;
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+}
\ No newline at end of file
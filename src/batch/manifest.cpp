@@ -0,0 +1,95 @@
+#include "manifest.hpp"
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace gameboy::batch {
+    std::runtime_error line_error(int line_number, const std::string& message)
+    {
+        return std::runtime_error{"Line " + std::to_string(line_number) + ": " + message};
+    }
+
+    std::int64_t parse_length(const std::string& value, int line_number)
+    {
+        try {
+            std::size_t end{};
+            auto length{std::stoll(value, &end)};
+            if (end == value.size() && length >= 0) {
+                return length;
+            }
+        }
+        catch (const std::logic_error&) {
+            // not a number, or out of range
+        }
+
+        throw line_error(line_number, "invalid length " + value);
+    }
+
+    Job parse_job(const std::string& line, int line_number)
+    {
+        std::istringstream stream{line};
+        Job job{};
+        stream >> std::quoted(job.rom);
+
+        // An option is a key up to the '=', then a value, which may be quoted on its own.
+        while (stream >> std::ws && !stream.eof()) {
+            std::string key{};
+            while (stream.peek() != '=' && stream.peek() != std::char_traits<char>::eof() && !std::isspace(stream.peek())) {
+                key += static_cast<char>(stream.get());
+            }
+
+            if (stream.get() != '=') {
+                throw line_error(line_number, "invalid option " + key);
+            }
+
+            std::string value{};
+            stream >> std::quoted(value);
+
+            if (key == "frames") {
+                job.unit = Job::Unit::frames;
+                job.length = parse_length(value, line_number);
+            }
+            else if (key == "cycles") {
+                job.unit = Job::Unit::cycles;
+                job.length = parse_length(value, line_number);
+            }
+            else if (key == "boot") {
+                job.boot_rom = value;
+            }
+            else if (key == "pass") {
+                job.pass_text = value;
+            }
+            else if (key == "fail") {
+                job.fail_text = value;
+            }
+            else {
+                throw line_error(line_number, "unknown option " + key);
+            }
+        }
+
+        return job;
+    }
+
+    std::vector<Job> read_manifest(const std::string& file_name)
+    {
+        std::ifstream file{file_name};
+        if (!file.is_open()) {
+            throw std::runtime_error{"The manifest file does not exist."};
+        }
+
+        std::vector<Job> jobs{};
+        std::string line{};
+        for (auto line_number{1}; std::getline(file, line); ++line_number) {
+            auto first{line.find_first_not_of(" \t\r")};
+            if (first == std::string::npos || line[first] == '#') {
+                continue;
+            }
+
+            jobs.push_back(parse_job(line, line_number));
+        }
+
+        return jobs;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef BATCH_MANIFEST_H
+#define BATCH_MANIFEST_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gameboy::batch {
+    struct Job {
+        enum class Unit {
+            frames,
+            cycles
+        };
+
+        std::string rom{};
+        std::string boot_rom{};   // run from the post-boot state if empty
+        Unit unit{Unit::frames};
+        std::int64_t length{600}; // the maximum run length
+        std::string pass_text{};  // stop with a pass once the serial output contains it
+        std::string fail_text{};  // stop with a failure once the serial output contains it
+    };
+
+    /*
+        Each non-empty line describes a ROM, followed by any of the options:
+
+            "path/to/rom.gb" frames=600 | cycles=N  boot=path  pass=text  fail=text
+
+        The path of the ROM and the value of an option may be quoted if they contain spaces,
+        as in pass="All tests passed". Lines starting with # are ignored.
+    */
+    std::vector<Job> read_manifest(const std::string& file_name);
+}
+
+#endif
\ No newline at end of file
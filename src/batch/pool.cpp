@@ -0,0 +1,69 @@
+#include "pool.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace gameboy::batch {
+    Pool::Pool(unsigned int worker_count)
+    {
+        for (auto i{0U}; i < std::max(worker_count, 1U); ++i) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+    }
+
+    // Run the tasks to completion. Tasks must not submit other tasks.
+    void Pool::run(std::vector<Task> tasks)
+    {
+        for (std::size_t i{0}; i < tasks.size(); ++i) {
+            queues[i % queues.size()]->tasks.push_back(std::move(tasks[i]));
+        }
+
+        std::vector<std::jthread> workers{};
+        for (auto i{0U}; i < queues.size(); ++i) {
+            workers.emplace_back([this, i]() { work(i); });
+        }
+    }
+
+    void Pool::work(unsigned int index)
+    {
+        while (true) {
+            auto task{pop(index)};
+            if (!task.has_value()) {
+                task = steal(index);
+            }
+
+            if (!task.has_value()) {
+                return; // no task is left anywhere
+            }
+
+            (*task)();
+        }
+    }
+
+    std::optional<Pool::Task> Pool::pop(unsigned int index)
+    {
+        auto& queue{*queues[index]};
+        std::scoped_lock lock{queue.mutex};
+        if (queue.tasks.empty()) {
+            return std::nullopt;
+        }
+
+        auto task{std::move(queue.tasks.back())};
+        queue.tasks.pop_back();
+        return task;
+    }
+
+    std::optional<Pool::Task> Pool::steal(unsigned int thief)
+    {
+        for (std::size_t offset{1}; offset < queues.size(); ++offset) {
+            auto& queue{*queues[(thief + offset) % queues.size()]};
+            std::scoped_lock lock{queue.mutex};
+            if (!queue.tasks.empty()) {
+                auto task{std::move(queue.tasks.front())};
+                queue.tasks.pop_front();
+                return task;
+            }
+        }
+
+        return std::nullopt;
+    }
+}
\ No newline at end of file
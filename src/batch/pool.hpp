@@ -0,0 +1,37 @@
+#ifndef BATCH_POOL_H
+#define BATCH_POOL_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace gameboy::batch {
+    /*
+        Every worker takes tasks from the back of its own queue. Once it runs out of
+        them, it steals from the front of the others, so long runs don't leave the
+        remaining workers idle.
+    */
+    class Pool {
+    public:
+        using Task = std::function<void()>;
+
+        explicit Pool(unsigned int worker_count);
+        void run(std::vector<Task> tasks);
+    private:
+        struct Queue {
+            std::mutex mutex{};
+            std::deque<Task> tasks{};
+        };
+
+        void work(unsigned int index);
+        std::optional<Task> pop(unsigned int index);
+        std::optional<Task> steal(unsigned int thief);
+
+        std::vector<std::unique_ptr<Queue>> queues{};
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "runner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <stdexcept>
+#include "boot_loader.hpp"
+#include "hash.hpp"
+#include "cartridge/banking.hpp"
+#include "cartridge/mbc.hpp"
+#include "cartridge/storage.hpp"
+
+namespace gameboy::batch {
+    using Clock = std::chrono::steady_clock;
+
+    std::unique_ptr<Machine> create_machine(const Job& job, Machine::ExecutionMode mode)
+    {
+        auto cartridge_memory{cartridge::create_storage(job.rom)};
+        auto p_mbc{cartridge::create_mbc(std::move(cartridge_memory))};
+        if (!job.boot_rom.empty()) {
+            auto p_boot_loader{std::make_unique<BootLoader>(job.boot_rom)};
+            cartridge::Banking cartridge_banking{std::move(p_boot_loader), std::move(p_mbc)};
+            return std::make_unique<Machine>(std::move(cartridge_banking), mode);
+        }
+
+        cartridge::Banking cartridge_banking{std::move(p_mbc)};
+        auto p_machine{std::make_unique<Machine>(std::move(cartridge_banking), mode)};
+        p_machine->preboot();
+        return p_machine;
+    }
+
+    Result run_job(const Job& job, Machine::ExecutionMode mode, ppu::Renderer renderer, bool is_idle_skipped)
+    {
+        Result result{.rom{job.rom}};
+        auto start{Clock::now()};
+
+        try {
+            auto p_machine{create_machine(job, mode)};
+            p_machine->set_renderer(renderer);
+            p_machine->set_idle_loop_skipping(is_idle_skipped);
+            p_machine->set_halt_skipping(is_idle_skipped);
+            auto limit{job.unit == Job::Unit::frames ? job.length * Machine::cycles_per_frame : job.length};
+
+            std::optional<Result::Status> decision{};
+            while (!decision.has_value() && result.cycles < limit) {
+                auto cycles{std::min<std::int64_t>(limit - result.cycles, Machine::cycles_per_frame)};
+                result.cycles += p_machine->run_cycles(static_cast<int>(cycles));
+
+                auto output{p_machine->get_serial_output()};
+                if (!job.fail_text.empty() && output.find(job.fail_text) != std::string_view::npos) {
+                    decision = Result::Status::fail;
+                    result.reason = "fail text received";
+                }
+                else if (!job.pass_text.empty() && output.find(job.pass_text) != std::string_view::npos) {
+                    decision = Result::Status::pass;
+                    result.reason = "pass text received";
+                }
+            }
+
+            if (!decision.has_value()) {
+                // Without a pass text, running to the end without an error is a pass.
+                decision = job.pass_text.empty() ? Result::Status::pass : Result::Status::fail;
+                result.reason = job.pass_text.empty() ? "completed" : "timed out";
+            }
+
+            result.status = *decision;
+            result.frame_hash = hash_bytes(p_machine->get_frame());
+        }
+        catch (const std::exception& error) {
+            result.status = Result::Status::error;
+            result.reason = error.what();
+        }
+
+        result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return result;
+    }
+
+    std::string to_string(Result::Status status)
+    {
+        switch (status) {
+            case Result::Status::pass:
+                return "pass";
+            case Result::Status::fail:
+                return "fail";
+            default:
+                return "error";
+        }
+    }
+
+    // Write the results as tab-separated values.
+    void write_results(const std::string& file_name, const std::vector<Result>& results)
+    {
+        std::ofstream file{file_name};
+        if (!file.is_open()) {
+            throw std::runtime_error{"The results file can't be created."};
+        }
+
+        file << "rom\tstatus\treason\temulated_cycles\thost_seconds\tcycles_per_second\tframe_hash\n";
+        for (const auto& result : results) {
+            auto cycles_per_second{result.seconds > 0 ? static_cast<double>(result.cycles) / result.seconds : 0.0};
+            auto reason{result.reason};
+            std::replace_if(reason.begin(), reason.end(), [](char c) { return c == '\t' || c == '\n'; }, ' ');
+
+            file << result.rom << '\t'
+                << to_string(result.status) << '\t'
+                << reason << '\t'
+                << result.cycles << '\t'
+                << std::fixed << std::setprecision(3) << result.seconds << '\t'
+                << std::setprecision(0) << cycles_per_second << '\t'
+                << std::hex << std::setw(16) << std::setfill('0') << result.frame_hash
+                << std::dec << std::setfill(' ') << '\n';
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "machine.hpp"
+#include "manifest.hpp"
+
+namespace gameboy::batch {
+    struct Result {
+        enum class Status {
+            pass,
+            fail,
+            error
+        };
+
+        std::string rom{};
+        Status status{Status::error};
+        std::string reason{};
+        std::int64_t cycles{};
+        double seconds{};
+        std::uint64_t frame_hash{};
+    };
+
+    Result run_job(
+        const Job& job,
+        Machine::ExecutionMode mode,
+        ppu::Renderer renderer = ppu::Renderer::fifo,
+        bool is_idle_skipped = true // the halted CPU and idle loops; off for runs which shouldn't depend on it
+    );
+    void write_results(const std::string& file_name, const std::vector<Result>& results);
+}
+
+#endif
\ No newline at end of file
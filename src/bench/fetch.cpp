@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "io/bus.hpp"
+#include "test/support.hpp"
+
+/*
+    Usage: gameboy-bench-fetch [--rounds N]
+
+    Times Bus::read_byte and Banking::read over the whole cartridge ROM (0x0000-0x7FFF) of
+    the busy test ROM, first with the boot ROM mapped over 0x0000-0x00FF and then after a
+    write to 0xFF50 has unmapped it. The bytes read are checked against the images, so the
+    boot ROM has to show up before the write and the cartridge after it. The numbers only
+    mean something in a Release build (-DCMAKE_BUILD_TYPE=Release).
+*/
+namespace gameboy::bench {
+    using Clock = std::chrono::steady_clock;
+    using Nanoseconds = std::chrono::duration<double, std::nano>;
+
+    constexpr int rom_end{0x8000};
+    constexpr int boot_rom_size{0x0100};
+
+    // The components a bus needs besides the cartridge, as a machine owns them.
+    struct Components {
+        system::Interrupt interrupt{};
+        system::Joypad joypad{interrupt};
+        system::Serial serial{interrupt};
+        system::Timer timer{interrupt};
+        apu::Psg psg{};
+        ppu::Lcd lcd{interrupt};
+        ppu::Vram vram{lcd};
+        ppu::Oam oam{lcd};
+    };
+
+    cartridge::Banking create_banking(std::span<const std::uint8_t> rom_image, const std::vector<std::uint8_t>& boot_image)
+    {
+        auto p_mbc{cartridge::create_mbc(cartridge::Storage{.rom{rom_image}})};
+        return cartridge::Banking{std::make_unique<BootLoader>(boot_image), std::move(p_mbc)};
+    }
+
+    // The sum of every byte the fetches should see.
+    std::uint64_t expected_sum(std::span<const std::uint8_t> rom_image, std::span<const std::uint8_t> boot_image, bool is_boot_rom_mapped)
+    {
+        std::uint64_t sum{0};
+        for (auto address{0}; address < rom_end; ++address) {
+            sum += is_boot_rom_mapped && address < boot_rom_size ? boot_image[address] : rom_image[address];
+        }
+
+        return sum;
+    }
+
+    struct Timing {
+        double best{}; // ns per read
+        bool is_correct{true};
+    };
+
+    template<typename Read>
+    Timing time_reads(int rounds, std::uint64_t expected, Read read)
+    {
+        constexpr int passes{50};
+        Timing timing{.best{Nanoseconds::max().count()}};
+        for (auto round{0}; round < rounds; ++round) {
+            auto start{Clock::now()};
+            for (auto pass{0}; pass < passes; ++pass) {
+                std::uint64_t sum{0};
+                for (auto address{0}; address < rom_end; ++address) {
+                    sum += read(address);
+                }
+
+                timing.is_correct &= sum == expected;
+            }
+
+            timing.best = std::min(timing.best, Nanoseconds{Clock::now() - start}.count() / (passes * rom_end));
+        }
+
+        return timing;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace gameboy;
+
+    auto rounds{20};
+    for (auto i{1}; i < argc; ++i) {
+        if (std::string_view{argv[i]} == "--rounds" && i + 1 < argc) {
+            rounds = std::max(std::stoi(argv[++i]), 1);
+        }
+    }
+
+    auto rom_image{test::build_busy_rom()};
+    std::vector<std::uint8_t> boot_image(bench::boot_rom_size);
+    std::transform(rom_image.cbegin(), rom_image.cbegin() + bench::boot_rom_size, boot_image.begin(), [](std::uint8_t value) {
+        return static_cast<std::uint8_t>(~value); // unlike the cartridge at every address
+    });
+
+    bench::Components components{};
+    io::Bus bus{io::Bundle{
+        .cartridge_space{bench::create_banking(rom_image, boot_image)},
+        .vram{components.vram},
+        .oam{components.oam},
+        .joypad{components.joypad},
+        .serial{components.serial},
+        .timer{components.timer},
+        .interrupt{components.interrupt},
+        .psg{components.psg},
+        .lcd{components.lcd}
+    }};
+    auto banking{bench::create_banking(rom_image, boot_image)};
+
+    auto failures{0};
+    for (auto is_boot_rom_mapped : {true, false}) {
+        if (!is_boot_rom_mapped) {
+            bus.write_byte(0xFF50, 0x01);
+            banking.disable_boot_rom();
+        }
+
+        auto expected{bench::expected_sum(rom_image, boot_image, is_boot_rom_mapped)};
+        auto bus_reads{bench::time_reads(rounds, expected, [&bus](int address) { return bus.read_byte(address); })};
+        auto banking_reads{bench::time_reads(rounds, expected, [&banking](int address) { return banking.read(address); })};
+        std::cout << std::fixed << std::setprecision(2) << (is_boot_rom_mapped ? "boot ROM mapped" : "boot ROM unmapped")
+            << ": Bus::read_byte " << bus_reads.best << " ns, Banking::read " << banking_reads.best << " ns per read\n";
+        if (!bus_reads.is_correct || !banking_reads.is_correct) {
+            std::cout << "  the bytes read don't match the images\n";
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
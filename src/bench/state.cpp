@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "test/support.hpp"
+
+/*
+    Usage: gameboy-bench-state [rom] [--rounds N]
+
+    Times save_state and load_state round trips on a machine which has been running for
+    a while, and checks that saving again after a load gives the same bytes. The numbers
+    only mean something in a Release build (-DCMAKE_BUILD_TYPE=Release).
+*/
+namespace gameboy::bench {
+    using Clock = std::chrono::steady_clock;
+    using Microseconds = std::chrono::duration<double, std::micro>;
+
+    struct Summary {
+        double median{};
+        double mean{};
+        double best{};
+    };
+
+    Summary summarize(std::vector<double> samples)
+    {
+        std::sort(samples.begin(), samples.end());
+        auto sum{0.0};
+        for (auto sample : samples) {
+            sum += sample;
+        }
+
+        return {.median{samples[samples.size() / 2]}, .mean{sum / static_cast<double>(samples.size())}, .best{samples.front()}};
+    }
+
+    void print(std::string_view name, const Summary& summary)
+    {
+        std::cout << std::fixed << std::setprecision(2) << name << ": median " << summary.median << " us, mean "
+            << summary.mean << " us, best " << summary.best << " us\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace gameboy;
+
+    std::string rom_file{};
+    auto rounds{1000};
+    for (auto i{1}; i < argc; ++i) {
+        std::string_view option{argv[i]};
+        if (option == "--rounds" && i + 1 < argc) {
+            rounds = std::max(std::stoi(argv[++i]), 1);
+        }
+        else {
+            rom_file = option;
+        }
+    }
+
+    auto rom_image{rom_file.empty() ? test::build_busy_rom() : std::vector<std::uint8_t>{}};
+    auto failures{0};
+    for (auto mode : {Machine::ExecutionMode::m_cycle, Machine::ExecutionMode::instruction}) {
+        auto p_machine{test::create_machine(rom_file, rom_image, mode)};
+        for (auto frame{0}; frame < 60; ++frame) {
+            p_machine->step_frame();
+        }
+
+        std::vector<std::uint8_t> state(p_machine->get_state_size());
+        std::vector<std::uint8_t> saved_again(state.size());
+        std::vector<double> saves{};
+        std::vector<double> loads{};
+        for (auto round{0}; round < rounds; ++round) {
+            p_machine->step_frame(); // so that every round saves a different state
+
+            auto start{bench::Clock::now()};
+            p_machine->save_state(state);
+            auto saved{bench::Clock::now()};
+            p_machine->load_state(state);
+            auto loaded{bench::Clock::now()};
+
+            saves.push_back(bench::Microseconds{saved - start}.count());
+            loads.push_back(bench::Microseconds{loaded - saved}.count());
+
+            p_machine->save_state(saved_again);
+            if (saved_again != state) {
+                ++failures;
+            }
+        }
+
+        std::cout << (mode == Machine::ExecutionMode::m_cycle ? "m_cycle" : "instruction") << ", "
+            << state.size() << " bytes, " << rounds << " rounds\n";
+        bench::print("  save", bench::summarize(saves));
+        bench::print("  load", bench::summarize(loads));
+    }
+
+    if (failures > 0) {
+        std::cout << failures << " round trips didn't restore the same state.\n";
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+#include "ppu/tile.hpp"
+
+/*
+    Usage: gameboy-bench-tile [--rounds N]
+
+    Checks that every kernel the host supports gives the same output as the scalar one,
+    including the counts which leave a remainder for the scalar loop, then times them on
+    the whole tile data (384 tiles) and on the palettes of a 160x144 frame.
+*/
+namespace gameboy::bench {
+    using Clock = std::chrono::steady_clock;
+    using Microseconds = std::chrono::duration<double, std::micro>;
+
+    constexpr std::array<ppu::Isa, 3> isas{ppu::Isa::scalar, ppu::Isa::sse2, ppu::Isa::avx2};
+
+    std::string_view to_string(ppu::Isa isa)
+    {
+        switch (isa) {
+            case ppu::Isa::sse2:
+                return "sse2";
+            case ppu::Isa::avx2:
+                return "avx2";
+            default:
+                return "scalar";
+        }
+    }
+
+    bool is_supported(ppu::Isa isa)
+    {
+        return static_cast<int>(isa) <= static_cast<int>(ppu::detect_isa());
+    }
+
+    // Keep the compiler from dropping the output of a kernel that is never read.
+    void touch(std::vector<std::uint8_t>& output)
+    {
+        asm volatile("" : : "r"(output.data()) : "memory");
+    }
+
+    // The best time of a call over the given rounds.
+    template<typename Kernel>
+    double time_kernel(int rounds, Kernel kernel)
+    {
+        constexpr int calls{100};
+        auto best{Microseconds::max()};
+        for (auto round{0}; round < rounds; ++round) {
+            auto start{Clock::now()};
+            for (auto call{0}; call < calls; ++call) {
+                kernel();
+            }
+
+            best = std::min(best, Microseconds{Clock::now() - start} / calls);
+        }
+
+        return best.count();
+    }
+
+    int check_kernels(std::mt19937& random)
+    {
+        auto mismatches{0};
+        for (std::size_t rows : {0, 1, 7, 8, 9, 15, 16, 17, 31, 384 * 8, 1001}) {
+            std::vector<std::uint8_t> data(rows * 2);
+            std::generate(data.begin(), data.end(), [&random]() { return static_cast<std::uint8_t>(random()); });
+
+            auto pixel_count{rows * 8};
+            std::vector<std::uint8_t> indices(pixel_count);
+            std::generate(indices.begin(), indices.end(), [&random]() { return static_cast<std::uint8_t>(random() % 12); });
+
+            ppu::PaletteColors colors{};
+            std::generate(colors.begin(), colors.end(), [&random]() { return static_cast<std::uint32_t>(random()); });
+
+            std::vector<std::uint8_t> expected_ids(pixel_count);
+            std::vector<std::uint8_t> expected_pixels(pixel_count * 4);
+            ppu::decode_tile_rows(data, expected_ids, ppu::Isa::scalar);
+            ppu::apply_palettes(indices, colors, expected_pixels, ppu::Isa::scalar);
+
+            for (auto isa : isas) {
+                if (isa == ppu::Isa::scalar || !is_supported(isa)) {
+                    continue;
+                }
+
+                // Fill the outputs with garbage first, so that a skipped remainder shows up.
+                std::vector<std::uint8_t> ids(pixel_count, 0xAA);
+                std::vector<std::uint8_t> pixels(pixel_count * 4, 0xAA);
+                ppu::decode_tile_rows(data, ids, isa);
+                ppu::apply_palettes(indices, colors, pixels, isa);
+
+                if (ids != expected_ids) {
+                    std::cout << to_string(isa) << ": decode_tile_rows differs from scalar for " << rows << " rows\n";
+                    ++mismatches;
+                }
+
+                if (pixels != expected_pixels) {
+                    std::cout << to_string(isa) << ": apply_palettes differs from scalar for " << pixel_count << " pixels\n";
+                    ++mismatches;
+                }
+            }
+        }
+
+        return mismatches;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace gameboy;
+
+    auto rounds{20};
+    for (auto i{1}; i < argc; ++i) {
+        if (std::string_view{argv[i]} == "--rounds" && i + 1 < argc) {
+            rounds = std::max(std::stoi(argv[++i]), 1);
+        }
+    }
+
+    std::mt19937 random{1};
+    auto mismatches{bench::check_kernels(random)};
+
+    constexpr std::size_t tile_count{384};
+    constexpr std::size_t frame_size{160 * 144};
+    std::vector<std::uint8_t> data(tile_count * 16);
+    std::generate(data.begin(), data.end(), [&random]() { return static_cast<std::uint8_t>(random()); });
+    std::vector<std::uint8_t> indices(frame_size);
+    std::generate(indices.begin(), indices.end(), [&random]() { return static_cast<std::uint8_t>(random() % 12); });
+    ppu::PaletteColors colors{};
+    std::generate(colors.begin(), colors.end(), [&random]() { return static_cast<std::uint32_t>(random()); });
+
+    std::vector<std::uint8_t> color_ids(tile_count * 64);
+    std::vector<std::uint8_t> pixels(frame_size * 4);
+    std::cout << "detected: " << bench::to_string(ppu::detect_isa()) << "\n";
+    for (auto isa : bench::isas) {
+        if (!bench::is_supported(isa)) {
+            std::cout << bench::to_string(isa) << ": not supported\n";
+            continue;
+        }
+
+        auto decoding{bench::time_kernel(rounds, [&]() {
+            ppu::decode_tile_rows(data, color_ids, isa);
+            bench::touch(color_ids);
+        })};
+        auto palettes{bench::time_kernel(rounds, [&]() {
+            ppu::apply_palettes(indices, colors, pixels, isa);
+            bench::touch(pixels);
+        })};
+
+        std::cout << std::fixed << std::setprecision(2) << bench::to_string(isa) << ": " << tile_count << " tiles "
+            << decoding << " us, " << frame_size << " palette lookups " << palettes << " us\n";
+    }
+
+    if (mismatches > 0) {
+        std::cout << mismatches << " outputs differ from the scalar kernels.\n";
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
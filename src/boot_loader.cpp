@@ -2,6 +2,7 @@
 #include <cassert>
 #include <fstream>
 #include <iterator>
+#include <utility>
 
 namespace gameboy {
     BootLoader::BootLoader(const std::string& file_name)
@@ -12,8 +13,18 @@ namespace gameboy {
         assert(boot_rom.size() >= 256);
     }
 
+    BootLoader::BootLoader(std::vector<std::uint8_t> image) : boot_rom{std::move(image)}
+    {
+        assert(boot_rom.size() >= 256);
+    }
+
     std::uint8_t BootLoader::read(int address) const
     {
         return boot_rom[address];
     }
+
+    const std::uint8_t* BootLoader::data() const
+    {
+        return boot_rom.data();
+    }
 }
\ No newline at end of file
@@ -9,7 +9,9 @@ namespace gameboy {
     class BootLoader {
     public:
         explicit BootLoader(const std::string& file_name);
+        explicit BootLoader(std::vector<std::uint8_t> image); // at least 256 bytes
         std::uint8_t read(int address) const;
+        const std::uint8_t* data() const;
     private:
         std::vector<std::uint8_t> boot_rom{};
     };
@@ -1,55 +1,77 @@
 #include "banking.hpp"
+#include <stdexcept>
 
 namespace gameboy::cartridge {
     Banking::Banking(std::unique_ptr<BootLoader> p_loader, std::unique_ptr<Mbc> p_controller)
-        : p_boot_loader{std::move(p_loader)}, p_mbc{std::move(p_controller)}
-        , reader{&Banking::read_before_boot}, writer{&Banking::write_before_boot}
+        : p_boot_loader{std::move(p_loader)}, p_mbc{std::move(p_controller)}, boot_rom_mapped{true}
     {
     }
 
-    Banking::Banking(std::unique_ptr<Mbc> p_controller)
-        : p_mbc{std::move(p_controller)}, reader{&Banking::read_after_boot}, writer{&Banking::write_after_boot}
+    Banking::Banking(std::unique_ptr<Mbc> p_controller) : p_mbc{std::move(p_controller)}
     {
     }
 
+    /*
+        The bus reads the cartridge through the pages returned by map, which it remaps once
+        when the boot ROM is disabled, so the boot ROM costs nothing on the fetch path after
+        that. Only the accesses that can't be mapped directly come here.
+    */
     std::uint8_t Banking::read(int address) const
     {
-        return reader(*this, address);
+        if (boot_rom_mapped && address < 0x0100) {
+            return p_boot_loader->read(address);
+        }
+
+        return p_mbc->read(address);
     }
 
     void Banking::write(int address, std::uint8_t value)
     {
-        writer(*this, address, value);
+        if (boot_rom_mapped) {
+            throw std::runtime_error{"You shouldn't modify the boot ROM."};
+        }
+
+        p_mbc->write(address, value);
     }
 
-    std::uint8_t Banking::read_before_boot(int address) const
+    const std::uint8_t* Banking::map(int address) const
     {
-        if (address < 0x0100) {
-            return p_boot_loader->read(address);
-        }
-        else {
-            return p_mbc->read(address);
+        if (boot_rom_mapped && address < 0x0100) {
+            return p_boot_loader->data();
         }
+
+        return p_mbc->map(address);
     }
 
-    std::uint8_t Banking::read_after_boot(int address) const
+    std::uint8_t* Banking::map_writable(int address)
     {
-        return p_mbc->read(address);
+        return p_mbc->map_writable(address);
     }
 
-    void Banking::write_before_boot(int address, std::uint8_t value)
+    void Banking::advance(int cycles)
     {
-        throw std::runtime_error{"You shouldn't modify the boot ROM."};
+        p_mbc->advance(cycles);
     }
 
-    void Banking::write_after_boot(int address, std::uint8_t value)
+    void Banking::disable_boot_rom()
     {
-        p_mbc->write(address, value);
+        boot_rom_mapped = false;
     }
 
-    void Banking::disable_boot_rom()
+    void Banking::save(state::Writer& out) const
     {
-        reader = &Banking::read_after_boot;
-        writer = &Banking::write_after_boot;
+        out.write(boot_rom_mapped);
+        p_mbc->save(out);
+    }
+
+    void Banking::load(state::Reader& in)
+    {
+        auto mapped{in.read<bool>()};
+        if (mapped && !p_boot_loader) {
+            throw std::runtime_error{"The save state requires a boot ROM."};
+        }
+
+        boot_rom_mapped = mapped;
+        p_mbc->load(in);
     }
 }
\ No newline at end of file
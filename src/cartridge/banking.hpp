@@ -2,7 +2,6 @@
 #define CARTRIDGE_BANKING_H
 
 #include <cstdint>
-#include <functional>
 #include <memory>
 #include "boot_loader.hpp"
 #include "mbc.hpp"
@@ -14,17 +13,16 @@ namespace gameboy::cartridge {
         explicit Banking(std::unique_ptr<Mbc> p_controller);
         std::uint8_t read(int address) const;
         void write(int address, std::uint8_t value);
+        const std::uint8_t* map(int address) const;
+        std::uint8_t* map_writable(int address);
+        void advance(int cycles);
         void disable_boot_rom();
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
     private:
-        std::uint8_t read_before_boot(int address) const;
-        std::uint8_t read_after_boot(int address) const;
-        void write_before_boot(int address, std::uint8_t value);
-        void write_after_boot(int address, std::uint8_t value);
-
         std::unique_ptr<BootLoader> p_boot_loader{};
         std::unique_ptr<Mbc> p_mbc{};
-        std::function<std::uint8_t(const Banking&, int)> reader;
-        std::function<void (Banking&, int, std::uint8_t)> writer;
+        bool boot_rom_mapped{};
     };
 }
 
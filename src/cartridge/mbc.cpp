@@ -1,7 +1,7 @@
 #include "mbc.hpp"
 #include <algorithm>
+#include <array>
 #include <fstream>
-#include <iostream>
 #include <stdexcept>
 
 namespace gameboy::cartridge {
@@ -9,8 +9,17 @@ namespace gameboy::cartridge {
     {
     }
 
+    std::string_view RomOnly::get_name() const
+    {
+        return "ROM ONLY";
+    }
+
     std::uint8_t RomOnly::read(int address) const
     {
+        if (address >= std::ssize(storage.rom)) {
+            return 0xFF; // no external RAM
+        }
+
         return storage.rom[address];
     }
 
@@ -19,16 +28,455 @@ namespace gameboy::cartridge {
         //throw std::runtime_error{"You shouldn't modify the cartridge ROM."};
     }
 
+    const std::uint8_t* RomOnly::map(int address) const
+    {
+        auto page{address & ~0xFF};
+        if (address >= 0x8000 || page + 0x100 > std::ssize(storage.rom)) {
+            return nullptr;
+        }
+
+        return &storage.rom[page];
+    }
+
+    constexpr int rom_bank_size{0x4000};
+    constexpr int ram_bank_size{0x2000};
+
+    bool is_ram_enable_value(std::uint8_t value)
+    {
+        return (value & 0x0F) == 0x0A;
+    }
+
+    BankedMbc::BankedMbc(Storage&& cartridge_storage, std::size_t ram_size)
+        : storage{std::move(cartridge_storage)}, ram(ram_size, 0xFF)
+        , ram_mask{ram.empty() ? 0 : static_cast<int>(std::min(ram.size(), std::size_t{ram_bank_size})) - 1}
+    {
+        // Any bank can be mapped as a whole. create_storage can't ensure that if the size in the header is unknown.
+        if (storage.rom.size() < 2 * rom_bank_size || storage.rom.size() % rom_bank_size != 0) {
+            throw std::runtime_error{"The cartridge ROM doesn't consist of whole banks.\n"};
+        }
+    }
+
+    std::uint8_t BankedMbc::read(int address) const
+    {
+        if (address < 0x4000) {
+            return p_rom_low[address];
+        }
+        else if (address < 0x8000) {
+            return p_rom_high[address - 0x4000];
+        }
+        else if (p_ram == nullptr) {
+            return 0xFF; // disabled or absent
+        }
+
+        return p_ram[(address - 0xA000) & ram_mask];
+    }
+
+    const std::uint8_t* BankedMbc::map(int address) const
+    {
+        if (address < 0x4000) {
+            return p_rom_low + address;
+        }
+        else if (address < 0x8000) {
+            return p_rom_high + (address - 0x4000);
+        }
+        else if (p_ram == nullptr) {
+            return nullptr;
+        }
+
+        return p_ram + ((address - 0xA000) & ram_mask);
+    }
+
+    std::uint8_t* BankedMbc::map_writable(int address)
+    {
+        if (address < 0xA000 || p_ram == nullptr || !is_ram_direct) {
+            return nullptr;
+        }
+
+        return p_ram + ((address - 0xA000) & ram_mask);
+    }
+
+    void BankedMbc::save(state::Writer& out) const
+    {
+        out.write_bytes(ram);
+        save_registers(out);
+    }
+
+    void BankedMbc::load(state::Reader& in)
+    {
+        in.read_bytes(ram);
+        load_registers(in);
+        update_banks();
+    }
+
+    // The bank numbers wrap around the actual size, as the unused upper bits aren't wired.
+    void BankedMbc::select_rom_banks(int low_bank, int high_bank)
+    {
+        auto bank_count{std::ssize(storage.rom) / rom_bank_size};
+        p_rom_low = storage.rom.data() + (low_bank % bank_count) * rom_bank_size;
+        p_rom_high = storage.rom.data() + (high_bank % bank_count) * rom_bank_size;
+    }
+
+    void BankedMbc::select_ram_bank(int bank, bool enabled)
+    {
+        if (!enabled || ram.empty()) {
+            p_ram = nullptr;
+            return;
+        }
+
+        auto bank_count{std::max(std::ssize(ram) / ram_bank_size, std::ptrdiff_t{1})};
+        p_ram = ram.data() + (bank % bank_count) * ram_bank_size;
+    }
+
+    void BankedMbc::write_ram(int address, std::uint8_t value)
+    {
+        if (p_ram != nullptr) {
+            p_ram[(address - 0xA000) & ram_mask] = value;
+        }
+    }
+
+    Mbc1::Mbc1(Storage&& cartridge_storage, std::size_t ram_size) : BankedMbc{std::move(cartridge_storage), ram_size}
+    {
+        update_banks();
+    }
+
+    std::string_view Mbc1::get_name() const
+    {
+        return "MBC1";
+    }
+
+    void Mbc1::write(int address, std::uint8_t value)
+    {
+        if (address < 0x2000) {
+            ram_enabled = is_ram_enable_value(value);
+        }
+        else if (address < 0x4000) {
+            bank1 = static_cast<std::uint8_t>(std::max(value & 0x1F, 1)); // bank 0 is mapped as 1
+        }
+        else if (address < 0x6000) {
+            bank2 = value & 0x03;
+        }
+        else if (address < 0x8000) {
+            advanced_mode = (value & 0x01) == 0x01;
+        }
+        else {
+            write_ram(address, value);
+            return;
+        }
+
+        update_banks();
+    }
+
+    void Mbc1::update_banks()
+    {
+        // In the advanced mode, the second register also switches 0x0000-0x3FFF and the RAM bank.
+        select_rom_banks(advanced_mode ? bank2 << 5 : 0, (bank2 << 5) | bank1);
+        select_ram_bank(advanced_mode ? bank2 : 0, ram_enabled);
+    }
+
+    void Mbc1::save_registers(state::Writer& out) const
+    {
+        out.write(ram_enabled);
+        out.write(bank1);
+        out.write(bank2);
+        out.write(advanced_mode);
+    }
+
+    void Mbc1::load_registers(state::Reader& in)
+    {
+        ram_enabled = in.read<bool>();
+        bank1 = in.read<std::uint8_t>();
+        bank2 = in.read<std::uint8_t>();
+        advanced_mode = in.read<bool>();
+    }
+
+    Mbc2::Mbc2(Storage&& cartridge_storage) : BankedMbc{std::move(cartridge_storage), 512}
+    {
+        is_ram_direct = false; // only the lower half of a byte is stored
+        update_banks();
+    }
+
+    std::string_view Mbc2::get_name() const
+    {
+        return "MBC2";
+    }
+
+    void Mbc2::write(int address, std::uint8_t value)
+    {
+        if (address < 0x4000) {
+            // Bit 8 of the address tells the two registers apart.
+            if ((address & 0x0100) == 0) {
+                ram_enabled = is_ram_enable_value(value);
+            }
+            else {
+                rom_bank = static_cast<std::uint8_t>(std::max(value & 0x0F, 1));
+            }
+
+            update_banks();
+        }
+        else if (address >= 0xA000) {
+            write_ram(address, value | 0xF0);
+        }
+    }
+
+    void Mbc2::update_banks()
+    {
+        select_rom_banks(0, rom_bank);
+        select_ram_bank(0, ram_enabled);
+    }
+
+    void Mbc2::save_registers(state::Writer& out) const
+    {
+        out.write(ram_enabled);
+        out.write(rom_bank);
+    }
+
+    void Mbc2::load_registers(state::Reader& in)
+    {
+        ram_enabled = in.read<bool>();
+        rom_bank = in.read<std::uint8_t>();
+    }
+
+    bool is_clock_register(std::uint8_t select)
+    {
+        return select >= 0x08 && select <= 0x0C;
+    }
+
+    Mbc3::Mbc3(Storage&& cartridge_storage, std::size_t ram_size)
+        : BankedMbc{std::move(cartridge_storage), ram_size}
+    {
+        update_banks();
+    }
+
+    std::string_view Mbc3::get_name() const
+    {
+        return "MBC3";
+    }
+
+    std::uint8_t Mbc3::read(int address) const
+    {
+        if (address >= 0xA000 && ram_enabled && is_clock_register(ram_select)) {
+            const std::array<std::uint8_t, 5> registers{
+                latched_clock.seconds, latched_clock.minutes, latched_clock.hours, latched_clock.day_low, latched_clock.day_high
+            };
+            return registers[ram_select - 0x08];
+        }
+
+        return BankedMbc::read(address);
+    }
+
+    void Mbc3::write(int address, std::uint8_t value)
+    {
+        if (address < 0x2000) {
+            ram_enabled = is_ram_enable_value(value);
+        }
+        else if (address < 0x4000) {
+            rom_bank = static_cast<std::uint8_t>(std::max(value & 0x7F, 1));
+        }
+        else if (address < 0x6000) {
+            ram_select = value;
+        }
+        else if (address < 0x8000) {
+            // Writing 0 then 1 copies the clock into the registers that can be read.
+            if (latch_signal == 0x00 && value == 0x01) {
+                update_clock();
+                latched_clock = clock;
+            }
+
+            latch_signal = value;
+        }
+        else if (ram_enabled && is_clock_register(ram_select)) {
+            update_clock();
+            switch (ram_select) {
+                case 0x08:
+                    clock.seconds = value & 0x3F;
+                    clock_cycles = 0; // writing the seconds also resets the fraction of a second
+                    break;
+                case 0x09:
+                    clock.minutes = value & 0x3F;
+                    break;
+                case 0x0A:
+                    clock.hours = value & 0x1F;
+                    break;
+                case 0x0B:
+                    clock.day_low = value;
+                    break;
+                default:
+                    clock.day_high = value & 0xC1;
+                    break;
+            }
+            return;
+        }
+        else {
+            write_ram(address, value);
+            return;
+        }
+
+        update_banks();
+    }
+
+    void Mbc3::advance(int cycles)
+    {
+        clock_cycles += cycles;
+    }
+
+    void Mbc3::update_banks()
+    {
+        select_rom_banks(0, rom_bank);
+        select_ram_bank(ram_select & 0x03, ram_enabled && ram_select < 0x04);
+    }
+
+    void Mbc3::save_registers(state::Writer& out) const
+    {
+        out.write(ram_enabled);
+        out.write(rom_bank);
+        out.write(ram_select);
+        out.write(latch_signal);
+        out.write(clock);
+        out.write(latched_clock);
+        out.write(clock_cycles);
+    }
+
+    void Mbc3::load_registers(state::Reader& in)
+    {
+        ram_enabled = in.read<bool>();
+        rom_bank = in.read<std::uint8_t>();
+        ram_select = in.read<std::uint8_t>();
+        latch_signal = in.read<std::uint8_t>();
+        clock = in.read<Clock>();
+        latched_clock = in.read<Clock>();
+        clock_cycles = in.read<std::int64_t>();
+    }
+
+    void Mbc3::update_clock()
+    {
+        static constexpr std::int64_t cycles_per_second{4'194'304};
+
+        auto elapsed{clock_cycles / cycles_per_second};
+        clock_cycles %= cycles_per_second;
+
+        constexpr std::uint8_t halt{0x40};
+        if ((clock.day_high & halt) != 0 || elapsed <= 0) {
+            return;
+        }
+
+        auto days{((clock.day_high & 0x01) << 8) | clock.day_low};
+        auto total{elapsed + clock.seconds + 60 * clock.minutes + 3600 * clock.hours + std::int64_t{86400} * days};
+
+        clock.seconds = static_cast<std::uint8_t>(total % 60);
+        total /= 60;
+        clock.minutes = static_cast<std::uint8_t>(total % 60);
+        total /= 60;
+        clock.hours = static_cast<std::uint8_t>(total % 24);
+        total /= 24;
+
+        constexpr std::uint8_t carry{0x80};
+        if (total > 511) {
+            clock.day_high |= carry;
+            total %= 512;
+        }
+
+        clock.day_low = static_cast<std::uint8_t>(total & 0xFF);
+        clock.day_high = static_cast<std::uint8_t>((clock.day_high & 0xFE) | (total >> 8));
+    }
+
+    Mbc5::Mbc5(Storage&& cartridge_storage, std::size_t ram_size, bool has_rumble)
+        : BankedMbc{std::move(cartridge_storage), ram_size}, ram_bank_mask{static_cast<std::uint8_t>(has_rumble ? 0x07 : 0x0F)}
+    {
+        update_banks();
+    }
+
+    std::string_view Mbc5::get_name() const
+    {
+        return "MBC5";
+    }
+
+    void Mbc5::write(int address, std::uint8_t value)
+    {
+        if (address < 0x2000) {
+            ram_enabled = is_ram_enable_value(value);
+        }
+        else if (address < 0x3000) {
+            rom_bank = (rom_bank & 0x100) | value; // bank 0 can be mapped as is
+        }
+        else if (address < 0x4000) {
+            rom_bank = (rom_bank & 0xFF) | ((value & 0x01) << 8);
+        }
+        else if (address < 0x6000) {
+            ram_bank = value & ram_bank_mask;
+        }
+        else if (address >= 0xA000) {
+            write_ram(address, value);
+            return;
+        }
+
+        update_banks();
+    }
+
+    void Mbc5::update_banks()
+    {
+        select_rom_banks(0, rom_bank);
+        select_ram_bank(ram_bank, ram_enabled);
+    }
+
+    void Mbc5::save_registers(state::Writer& out) const
+    {
+        out.write(ram_enabled);
+        out.write(rom_bank);
+        out.write(ram_bank);
+    }
+
+    void Mbc5::load_registers(state::Reader& in)
+    {
+        ram_enabled = in.read<bool>();
+        rom_bank = in.read<int>();
+        ram_bank = in.read<std::uint8_t>();
+    }
+
+    std::size_t get_ram_size(std::uint8_t code)
+    {
+        switch (code) {
+            case 0x01:
+                return 0x0800; // unofficial
+            case 0x02:
+                return 0x2000;
+            case 0x03:
+                return 0x8000;
+            case 0x04:
+                return 0x20000;
+            case 0x05:
+                return 0x10000;
+            default:
+                return 0;
+        }
+    }
+
     std::unique_ptr<Mbc> create_mbc(Storage&& storage)
     {
         auto type{storage.rom[0x0147]};
-        std::cout << "Create MBC: ";
+        auto ram_size{get_ram_size(storage.rom[0x0149])};
         switch (type) {
             case 0x01:
-                std::cout << "MBC1\n";
-                return std::make_unique<RomOnly>(std::move(storage));
+            case 0x02:
+            case 0x03:
+                return std::make_unique<Mbc1>(std::move(storage), ram_size);
+            case 0x05:
+            case 0x06:
+                return std::make_unique<Mbc2>(std::move(storage));
+            case 0x0F:
+            case 0x10:
+            case 0x11:
+            case 0x12:
+            case 0x13:
+                return std::make_unique<Mbc3>(std::move(storage), ram_size);
+            case 0x19:
+            case 0x1A:
+            case 0x1B:
+                return std::make_unique<Mbc5>(std::move(storage), ram_size);
+            case 0x1C:
+            case 0x1D:
+            case 0x1E:
+                return std::make_unique<Mbc5>(std::move(storage), ram_size, true);
             default:
-                std::cout << "ROM ONLY\n";
                 return std::make_unique<RomOnly>(std::move(storage));
         }
     }
@@ -4,24 +4,158 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string_view>
 #include <vector>
+#include "state.hpp"
 #include "storage.hpp"
 
 namespace gameboy::cartridge {
     class Mbc {
     public:
+        virtual std::string_view get_name() const = 0; // the type in the cartridge header, for diagnostics
         virtual std::uint8_t read(int address) const = 0;
         virtual void write(int address, std::uint8_t value) = 0;
+
+        // Return the 256-byte page containing the address, or nullptr if it can't be accessed directly.
+        virtual const std::uint8_t* map(int) const { return nullptr; }
+        virtual std::uint8_t* map_writable(int) { return nullptr; }
+
+        // Let the given clock cycles of emulated time pass, for a cartridge which keeps time.
+        virtual void advance(int) {}
+
+        // The banking registers and the external RAM, if any.
+        virtual void save(state::Writer&) const {}
+        virtual void load(state::Reader&) {}
         virtual ~Mbc() = default;
     };
 
     class RomOnly : public Mbc {
     public:
         explicit RomOnly(Storage&& cartridge_storage);
+        virtual std::string_view get_name() const override;
         virtual std::uint8_t read(int address) const override;
         virtual void write(int address, std::uint8_t value) override;
+        virtual const std::uint8_t* map(int address) const override;
+    private:
+        Storage storage;
+    };
+
+    /*
+        A controller with a switchable ROM bank at 0x4000-0x7FFF and external RAM at 0xA000-0xBFFF.
+        The base pointers of the current banks are recomputed on every bank switch, so that
+        an access is a plain offset from them rather than a bank calculation.
+    */
+    class BankedMbc : public Mbc {
+    public:
+        BankedMbc(const BankedMbc&) = delete; // the base pointers refer to the RAM of this object
+        BankedMbc& operator=(const BankedMbc&) = delete;
+        virtual std::uint8_t read(int address) const override;
+        virtual const std::uint8_t* map(int address) const override;
+        virtual std::uint8_t* map_writable(int address) override;
+        virtual void save(state::Writer& out) const override;
+        virtual void load(state::Reader& in) override;
+    protected:
+        BankedMbc(Storage&& cartridge_storage, std::size_t ram_size);
+
+        virtual void update_banks() = 0; // call select_rom_banks and select_ram_bank
+        virtual void save_registers(state::Writer& out) const = 0;
+        virtual void load_registers(state::Reader& in) = 0;
+
+        void select_rom_banks(int low_bank, int high_bank);
+        void select_ram_bank(int bank, bool enabled);
+        void write_ram(int address, std::uint8_t value);
+
+        bool is_ram_direct{true}; // false if every RAM access has to go through read and write
     private:
         Storage storage;
+        std::vector<std::uint8_t> ram;
+        int ram_mask;
+
+        const std::uint8_t* p_rom_low{};  // 0x0000-0x3FFF
+        const std::uint8_t* p_rom_high{}; // 0x4000-0x7FFF
+        std::uint8_t* p_ram{};            // 0xA000-0xBFFF, nullptr if disabled
+    };
+
+    class Mbc1 : public BankedMbc {
+    public:
+        Mbc1(Storage&& cartridge_storage, std::size_t ram_size);
+        virtual std::string_view get_name() const override;
+        virtual void write(int address, std::uint8_t value) override;
+    private:
+        virtual void update_banks() override;
+        virtual void save_registers(state::Writer& out) const override;
+        virtual void load_registers(state::Reader& in) override;
+
+        bool ram_enabled{false};
+        std::uint8_t bank1{1}; // 5 bits
+        std::uint8_t bank2{0}; // 2 bits: the upper ROM bank bits or the RAM bank
+        bool advanced_mode{false};
+    };
+
+    // 512 half-bytes of built-in RAM, of which the upper half of a byte always reads as 1.
+    class Mbc2 : public BankedMbc {
+    public:
+        explicit Mbc2(Storage&& cartridge_storage);
+        virtual std::string_view get_name() const override;
+        virtual void write(int address, std::uint8_t value) override;
+    private:
+        virtual void update_banks() override;
+        virtual void save_registers(state::Writer& out) const override;
+        virtual void load_registers(state::Reader& in) override;
+
+        bool ram_enabled{false};
+        std::uint8_t rom_bank{1}; // 4 bits
+    };
+
+    class Mbc3 : public BankedMbc {
+    public:
+        Mbc3(Storage&& cartridge_storage, std::size_t ram_size);
+        virtual std::string_view get_name() const override;
+        virtual std::uint8_t read(int address) const override;
+        virtual void write(int address, std::uint8_t value) override;
+        virtual void advance(int cycles) override;
+    private:
+        /*
+            The real time clock counts the emulated clock cycles rather than the host time, so
+            that a run can be repeated exactly. It's brought up to date whenever it's latched
+            or written, with the whole seconds passed since the last time.
+        */
+        struct Clock {
+            std::uint8_t seconds;
+            std::uint8_t minutes;
+            std::uint8_t hours;
+            std::uint8_t day_low;
+            std::uint8_t day_high; // bit 0: day bit 8, bit 6: halt, bit 7: day counter carry
+        };
+
+        virtual void update_banks() override;
+        virtual void save_registers(state::Writer& out) const override;
+        virtual void load_registers(state::Reader& in) override;
+        void update_clock();
+
+        bool ram_enabled{false};
+        std::uint8_t rom_bank{1};    // 7 bits
+        std::uint8_t ram_select{0};  // 0x00-0x03: RAM bank, 0x08-0x0C: clock register
+        std::uint8_t latch_signal{0xFF};
+        Clock clock{};
+        Clock latched_clock{};
+        std::int64_t clock_cycles{}; // passed since the clock was last brought up to date
+    };
+
+    class Mbc5 : public BankedMbc {
+    public:
+        Mbc5(Storage&& cartridge_storage, std::size_t ram_size, bool has_rumble = false);
+        virtual std::string_view get_name() const override;
+        virtual void write(int address, std::uint8_t value) override;
+    private:
+        virtual void update_banks() override;
+        virtual void save_registers(state::Writer& out) const override;
+        virtual void load_registers(state::Reader& in) override;
+
+        std::uint8_t ram_bank_mask; // bit 3 of the RAM bank register drives the motor of a rumble cartridge
+        bool ram_enabled{false};
+        int rom_bank{1}; // 9 bits
+        std::uint8_t ram_bank{0}; // 4 bits
     };
 
     std::unique_ptr<Mbc> create_mbc(Storage&& storage);
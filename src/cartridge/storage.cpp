@@ -1,36 +1,181 @@
 #include "storage.hpp"
-#include <algorithm>
+#include <filesystem>
 #include <fstream>
-#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MEMORY_MAPPED_ROM
+#endif
 
 namespace gameboy::cartridge {
-    Storage create_storage(const std::string& file_name)
+    class RomImage {
+    public:
+        explicit RomImage(const std::filesystem::path& path);
+        RomImage(const RomImage&) = delete;
+        RomImage& operator=(const RomImage&) = delete;
+        ~RomImage();
+        std::span<const std::uint8_t> get_bytes() const;
+    private:
+        bool map(const std::filesystem::path& path);
+        void read(const std::filesystem::path& path);
+
+        std::span<const std::uint8_t> bytes{};
+        void* p_mapping{};
+        std::vector<std::uint8_t> buffer{}; // used only if the file can't be mapped
+    };
+
+    RomImage::RomImage(const std::filesystem::path& path)
     {
-        static constexpr int bank_size{0x4000};
+        if (!map(path)) {
+            read(path);
+        }
+    }
 
-        std::cout << "Load cartridge: " << file_name << "\n";
-        std::ifstream file{file_name, std::ios::binary};
+    RomImage::~RomImage()
+    {
+#ifdef MEMORY_MAPPED_ROM
+        if (p_mapping != nullptr) {
+            munmap(p_mapping, bytes.size());
+        }
+#endif
+    }
+
+    std::span<const std::uint8_t> RomImage::get_bytes() const
+    {
+        return bytes;
+    }
 
+    bool RomImage::map(const std::filesystem::path& path)
+    {
+#ifdef MEMORY_MAPPED_ROM
+        auto descriptor{open(path.c_str(), O_RDONLY)};
+        if (descriptor < 0) {
+            return false;
+        }
+
+        struct stat status{};
+        void* p_data{MAP_FAILED};
+        if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+            p_data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        }
+
+        close(descriptor); // the mapping stays valid without the descriptor
+        if (p_data == MAP_FAILED) {
+            return false;
+        }
+
+        p_mapping = p_data;
+        bytes = {static_cast<const std::uint8_t*>(p_data), static_cast<std::size_t>(status.st_size)};
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void RomImage::read(const std::filesystem::path& path)
+    {
+        std::ifstream file{path, std::ios::binary | std::ios::ate};
         if (!file.is_open()) {
             throw std::runtime_error{"The cartridge file does not exist.\n"};
         }
 
-        Storage storage{};
-        storage.rom.resize(bank_size);
-        std::generate(storage.rom.begin(), storage.rom.end(), [&file](){ return file.get(); });
+        auto size{static_cast<std::streamoff>(file.tellg())};
+        if (size < 0) {
+            throw std::runtime_error{"The cartridge file can't be read.\n"};
+        }
+
+        buffer.resize(static_cast<std::size_t>(size));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        if (!file || file.gcount() != static_cast<std::streamsize>(buffer.size())) {
+            throw std::runtime_error{"The cartridge file can't be read.\n"};
+        }
+
+        bytes = buffer;
+    }
+
+    // Every cartridge loaded in the process gets its image from here.
+    class ImageCache {
+    public:
+        std::shared_ptr<const RomImage> get(const std::filesystem::path& path);
+    private:
+        std::mutex mutex{};
+        std::map<std::filesystem::path, std::weak_ptr<const RomImage>> images{};
+    };
+
+    std::shared_ptr<const RomImage> ImageCache::get(const std::filesystem::path& path)
+    {
+        std::scoped_lock lock{mutex};
+        auto p_image{images[path].lock()};
+        if (!p_image) {
+            std::erase_if(images, [](const auto& item) { return item.second.expired(); });
+            p_image = std::make_shared<const RomImage>(path);
+            images[path] = p_image;
+        }
+
+        return p_image;
+    }
+
+    ImageCache shared_images{};
+
+    // The ROM size declared in the cartridge header, or nothing if the code is unknown.
+    std::optional<std::size_t> declared_size(std::uint8_t code)
+    {
+        static constexpr std::size_t bank_size{0x4000};
+
+        switch (code) {
+            case 0x52:
+                return 72 * bank_size;
+            case 0x53:
+                return 80 * bank_size;
+            case 0x54:
+                return 96 * bank_size;
+            default:
+                if (code <= 0x08) {
+                    return (2 * bank_size) << code;
+                }
+
+                return std::nullopt;
+        }
+    }
+
+    Storage create_storage(const std::string& file_name)
+    {
+        static constexpr std::size_t header_end{0x0150};
+
+        std::error_code error{};
+        auto path{std::filesystem::canonical(file_name, error)};
+        if (error) {
+            throw std::runtime_error{"The cartridge file does not exist.\n"};
+        }
+
+        // A directory or a device would report a size that has nothing to do with its contents.
+        if (!std::filesystem::is_regular_file(path, error)) {
+            throw std::runtime_error{"The cartridge file is not a regular file.\n"};
+        }
+
+        auto p_image{shared_images.get(path)};
+        auto rom{p_image->get_bytes()};
+        if (rom.size() < header_end) {
+            throw std::runtime_error{"The cartridge file is too small to contain a header.\n"};
+        }
 
-        auto rom_type{storage.rom[0x0148]};
-        auto number_of_rom_banks{(2 << (rom_type / 16)) + (2 << (rom_type % 16))};
-        storage.rom.resize(bank_size * number_of_rom_banks);
+        if (auto size{declared_size(rom[0x0148])}; size.has_value()) {
+            if (rom.size() < *size) {
+                throw std::runtime_error{"The cartridge file is shorter than its header declares.\n"};
+            }
 
-        std::cout << "ROM size: " << storage.rom.size() << "\n";
-        for (auto i{1}; i < number_of_rom_banks; ++i) {
-            auto begin{storage.rom.begin() + i * bank_size};
-            auto end{storage.rom.begin() + (i + 1) * bank_size};
-            std::generate(begin, end, [&file](){ return file.get(); });
+            rom = rom.first(*size);
         }
 
-        return storage;
+        return {.p_image{std::move(p_image)}, .rom{rom}};
     }
 }
\ No newline at end of file
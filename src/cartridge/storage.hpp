@@ -1,14 +1,23 @@
 #ifndef CARTRIDGE_STORAGE_H
 #define CARTRIDGE_STORAGE_H
 
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
-#include <vector>
 
 namespace gameboy::cartridge {
+    class RomImage;
+
     struct Storage {
-        std::vector<std::uint8_t> rom;
+        std::shared_ptr<const RomImage> p_image{}; // shared by every cartridge loaded from the same file
+        std::span<const std::uint8_t> rom{};
     };
 
+    /*
+        The ROM is mapped into memory read-only where the platform allows it, or else read in
+        one go. Loading a file that is already loaded in the process reuses the same image.
+    */
     Storage create_storage(const std::string& file_name);
 }
 
@@ -1,86 +1,49 @@
 #include "core.hpp"
 #include <array>
-#include <bitset>
 #include <cstdint>
-#include <string>
 #include <iostream>
+#include <stdexcept>
 
 namespace gameboy::cpu {
-    Instruction::SideEffect halting(int, Registers&, gameboy::io::Bus& mmu)
-    {
-        if (has_pending_interrupt(mmu)) {
-            return {};
-        }
-
-        return {.cycle_adjustment{-1}};
-    }
-
-    Instruction::SideEffect handle_interrupt(int cycle, Registers& regs, gameboy::io::Bus& mmu)
-    {
-        static auto reset_flag{[](gameboy::io::Bus& mmu, std::bitset<8>& flag, int bit){
-            flag.reset(bit);
-            mmu.write_byte(0xFF0F, static_cast<std::uint8_t>(flag.to_ulong()));
-        }};
-
-        switch (cycle) {
-            case 2:
-                mmu.write_byte(--regs.sp, regs.program_counter.get_high());
-                return {};
-            case 3:
-                mmu.write_byte(--regs.sp, regs.program_counter.get_low<std::uint8_t>());
+    // HALTED: wait for an interrupt
+    struct Halting {
+        Instruction::SideEffect operator()(int, Registers&, gameboy::io::Bus& mmu)
+        {
+            if (has_pending_interrupt(mmu)) {
                 return {};
-            case 4: {
-                    regs.program_counter.set_high(0);
-                    std::uint8_t flag{mmu.read_byte(0xFF0F)};
-                    std::bitset<8> view{static_cast<uint8_t>(mmu.read_byte(0xFFFF) & flag)};
+            }
 
-                    for (auto i{0}; i < 5; ++i) {
-                        if (view.test(i)) {
-                            flag = static_cast<std::uint8_t>(flag & ~(1 << i));
-                            mmu.write_byte(0xFF0F, flag);
-                            regs.program_counter.set_low(static_cast<std::uint8_t>(0x40 + i * 0x08));
-                            break;
-                        }
-                    }
-                }
-                return {};
-            default:
-                return {};
+            return {.cycle_adjustment{-1}};
         }
-    }
+    };
 
-    Core::Core(std::unique_ptr<io::Bus> bus) : p_bus{std::move(bus)}
-    {
-    }
-
-    void Core::tick()
-    {
-        execute(instruction.operation);
-
-        if (m_cycle == instruction.duration) {
-            auto opcode{p_bus->read_byte(regs.program_counter++)};
-            instruction = decode(opcode);
-            m_cycle = 0;
-
-            check_interrupt();
+    // ISR: dispatch to the interrupt handler
+    struct HandleInterrupt {
+        Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
+        {
+            switch (cycle) {
+                case 2:
+                    mmu.write_byte(--regs.sp, regs.program_counter.get_high());
+                    return {};
+                case 3:
+                    mmu.write_byte(--regs.sp, regs.program_counter.get_low<std::uint8_t>());
+                    return {};
+                case 4:
+                    regs.program_counter.set_high(0);
+                    if (auto option{mmu.get_interrupt().acknowledge()}; option.has_value()) {
+                        regs.program_counter.set_low(static_cast<std::uint8_t>(0x40 + *option * 0x08));
+                    }
+                    return {};
+                default:
+                    return {};
+            }
         }
-    }
-
-    void Core::preboot()
-    {
-        regs.af.set_high(0x01);
-        regs.af.set_low(FlagRegister{0xB0});
-        regs.bc = 0x0013;
-        regs.de = 0x00D8;
-        regs.hl = 0x014D;
-        regs.sp = 0xFFFE;
-        regs.program_counter = 0x0100;
-    }
+    };
 
-    Instruction Core::decode(int opcode)
+    constexpr Instruction decode(int opcode)
     {
-        static constexpr auto with_flag{true};
-        static constexpr auto without_flag{false};
+        constexpr auto with_flag{true};
+        constexpr auto without_flag{false};
 
         switch (opcode) {
             using enum Instruction::Operand;
@@ -89,2539 +52,2515 @@ namespace gameboy::cpu {
             case 0x00:
                 return {
                     .opcode{opcode}, .name{"NOP"}, .duration{1},
-                    .operation{Nop{}}
+                    .operation{operate<Nop>}
                 };
             case 0x01:
                 return {
                     .opcode{opcode}, .name{"LD BC, u16"}, .duration{3},
-                    .operation{Ld<reg16, u16>{regs.bc}}
+                    .operation{operate<Ld<reg16, u16, RegBC>>}
                 };
             case 0x02:
                 return {
                     .opcode{opcode}, .name{"LD (BC), A"}, .duration{2},
-                    .operation{Ld<reg16_address, reg8>{regs.bc, Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg16_address, reg8, RegBC, RegA>>}
                 };
             case 0x03:
                 return {
                     .opcode{opcode}, .name{"INC BC"}, .duration{2},
-                    .operation{Inc<reg16>{regs.bc}}
+                    .operation{operate<Inc<reg16, RegBC>>}
                 };
             case 0x04:
                 return {
                     .opcode{opcode}, .name{"INC B"}, .duration{1},
-                    .operation{Inc<reg8>{Reg16High{regs.bc}}}
+                    .operation{operate<Inc<reg8, RegB>>}
                 };
             case 0x05:
                 return {
                     .opcode{opcode}, .name{"DEC B"}, .duration{1},
-                    .operation{Dec<reg8>{Reg16High{regs.bc}}}
+                    .operation{operate<Dec<reg8, RegB>>}
                 };
             case 0x06:
                 return {
                     .opcode{opcode}, .name{"LD B, u8"}, .duration{2},
-                    .operation{Ld<reg8, u8>{Reg16High{regs.bc}}}
+                    .operation{operate<Ld<reg8, u8, RegB>>}
                 };
             case 0x07:
                 return {
                     .opcode{opcode}, .name{"RLCA"}, .duration{1},
-                    .operation{Rlca{}}
+                    .operation{operate<Rlca>}
                 };
             case 0x08:
                 return {
                     .opcode{opcode}, .name{"LD (u16), SP"}, .duration{5},
-                    .operation{Ld<u16_address, reg16>{regs.sp}}
+                    .operation{operate<Ld<u16_address, reg16, RegSP>>}
                 };
             case 0x09:
                 return {
                     .opcode{opcode}, .name{"ADD HL, BC"}, .duration{2},
-                    .operation{Add<reg16, reg16>{regs.hl, regs.bc}}
+                    .operation{operate<Add<reg16, reg16, RegHL, RegBC>>}
                 };
             case 0x0A:
                 return {
                     .opcode{opcode}, .name{"LD A, (BC)"}, .duration{2},
-                    .operation{Ld<reg8, reg16_address>{Reg16High{regs.af}, regs.bc}}
+                    .operation{operate<Ld<reg8, reg16_address, RegA, RegBC>>}
                 };
             case 0x0B:
                 return {
                     .opcode{opcode}, .name{"DEC BC"}, .duration{2},
-                    .operation{Dec<reg16>{regs.bc}}
+                    .operation{operate<Dec<reg16, RegBC>>}
                 };
             case 0x0C:
                 return {
                     .opcode{opcode}, .name{"INC C"}, .duration{1},
-                    .operation{Inc<reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Inc<reg8, RegC>>}
                 };
             case 0x0D:
                 return {
                     .opcode{opcode}, .name{"DEC C"}, .duration{1},
-                    .operation{Dec<reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Dec<reg8, RegC>>}
                 };
             case 0x0E:
                 return {
                     .opcode{opcode}, .name{"LD C, u8"}, .duration{2},
-                    .operation{Ld<reg8, u8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg8, u8, RegC>>}
                 };
             case 0x0F:
                 return {
                     .opcode{opcode}, .name{"RRCA"}, .duration{1},
-                    .operation{Rrca{}}
+                    .operation{operate<Rrca>}
                 };
             case 0x10:
                 return {
                     .opcode{opcode}, .name{"STOP"}, .duration{1},
-                    .operation{Stop{}}
+                    .operation{operate<Stop>}
                 };
             case 0x11:
                 return {
                     .opcode{opcode}, .name{"LD DE, u16"}, .duration{3},
-                    .operation{Ld<reg16, u16>{regs.de}}
+                    .operation{operate<Ld<reg16, u16, RegDE>>}
                 };
             case 0x12:
                 return {
                     .opcode{opcode}, .name{"LD (DE), A"}, .duration{2},
-                    .operation{Ld<reg16_address, reg8>{regs.de, Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg16_address, reg8, RegDE, RegA>>}
                 };
             case 0x13:
                 return {
                     .opcode{opcode}, .name{"INC DE"}, .duration{2},
-                    .operation{Inc<reg16>{regs.de}}
+                    .operation{operate<Inc<reg16, RegDE>>}
                 };
             case 0x14:
                 return {
                     .opcode{opcode}, .name{"INC D"}, .duration{1},
-                    .operation{Inc<reg8>{Reg16High{regs.de}}}
+                    .operation{operate<Inc<reg8, RegD>>}
                 };
             case 0x15:
                 return {
                     .opcode{opcode}, .name{"DEC D"}, .duration{1},
-                    .operation{Dec<reg8>{Reg16High{regs.de}}}
+                    .operation{operate<Dec<reg8, RegD>>}
                 };
             case 0x16:
                 return {
                     .opcode{opcode}, .name{"LD D, u8"}, .duration{2},
-                    .operation{Ld<reg8, u8>{Reg16High{regs.de}}}
+                    .operation{operate<Ld<reg8, u8, RegD>>}
                 };
             case 0x17:
                 return {
                     .opcode{opcode}, .name{"RLA"}, .duration{1},
-                    .operation{Rla{}}
+                    .operation{operate<Rla>}
                 };
             case 0x18:
                 return {
                     .opcode{opcode}, .name{"JR i8"}, .duration{3},
-                    .operation = Jr{}
+                    .operation{operate<Jr<void, i8>>}
                 };
             case 0x19:
                 return {
                     .opcode{opcode}, .name{"ADD HL, DE"}, .duration{2},
-                    .operation{Add<reg16, reg16>{regs.hl, regs.de}}
+                    .operation{operate<Add<reg16, reg16, RegHL, RegDE>>}
                 };
             case 0x1A:
                 return {
                     .opcode{opcode}, .name{"LD A, (DE)"}, .duration{2},
-                    .operation{Ld<reg8, reg16_address>{Reg16High{regs.af}, regs.de}}
+                    .operation{operate<Ld<reg8, reg16_address, RegA, RegDE>>}
                 };
             case 0x1B:
                 return {
                     .opcode{opcode}, .name{"DEC DE"}, .duration{2},
-                    .operation{Dec<reg16>{regs.de}}
+                    .operation{operate<Dec<reg16, RegDE>>}
                 };
             case 0x1C:
                 return {
                     .opcode{opcode}, .name{"INC E"}, .duration{1},
-                    .operation{Inc<reg8>{Reg16Low{regs.de}}}
+                    .operation{operate<Inc<reg8, RegE>>}
                 };
             case 0x1D:
                 return {
                     .opcode{opcode}, .name{"DEC E"}, .duration{1},
-                    .operation{Dec<reg8>{Reg16Low{regs.de}}}
+                    .operation{operate<Dec<reg8, RegE>>}
                 };
             case 0x1E:
                 return {
                     .opcode{opcode}, .name{"LD E, u8"}, .duration{2},
-                    .operation{Ld<reg8, u8>{Reg16Low{regs.de}}}
+                    .operation{operate<Ld<reg8, u8, RegE>>}
                 };
             case 0x1F:
                 return {
                     .opcode{opcode}, .name{"RRA"}, .duration{1},
-                    .operation{Rra{}}
+                    .operation{operate<Rra>}
                 };
             case 0x20:
                 return {
                     .opcode{opcode}, .name{"JR NZ, i8"}, .duration{3},
-                    .operation{Jr{FlagPredicate<Flag::zero, false>{}}}
+                    .operation{operate<Jr<FlagPredicate<Flag::zero, false>, i8>>}
                 };
             case 0x21:
                 return {
                     .opcode{opcode}, .name{"LD HL, u16"}, .duration{3},
-                    .operation{Ld<reg16, u16>{regs.hl}}
+                    .operation{operate<Ld<reg16, u16, RegHL>>}
                 };
             case 0x22:
                 return {
                     .opcode{opcode}, .name{"LD (HL+), A"}, .duration{2},
-                    .operation{Ldi<reg16_address, reg8>{regs.hl}}
+                    .operation{operate<Ldi<reg16_address, reg8, RegHL>>}
                 };
             case 0x23:
                 return {
                     .opcode{opcode}, .name{"INC HL"}, .duration{2},
-                    .operation{Inc<reg16>{regs.hl}}
+                    .operation{operate<Inc<reg16, RegHL>>}
                 };
             case 0x24:
                 return {
                     .opcode{opcode}, .name{"INC H"}, .duration{1},
-                    .operation{Inc<reg8>{Reg16High{regs.hl}}}
+                    .operation{operate<Inc<reg8, RegH>>}
                 };
             case 0x25:
                 return {
                     .opcode{opcode}, .name{"DEC H"}, .duration{1},
-                    .operation{Dec<reg8>{Reg16High{regs.hl}}}
+                    .operation{operate<Dec<reg8, RegH>>}
                 };
             case 0x26:
                 return {
                     .opcode{opcode}, .name{"LD H, u8"}, .duration{2},
-                    .operation{Ld<reg8, u8>{Reg16High{regs.hl}}}
+                    .operation{operate<Ld<reg8, u8, RegH>>}
                 };
             case 0x27:
                 return {
                     .opcode{opcode}, .name{"DAA"}, .duration{1},
-                    .operation{Daa{}}
+                    .operation{operate<Daa>}
                 };
             case 0x28:
                 return {
                     .opcode{opcode}, .name{"JR Z, i8"}, .duration{3},
-                    .operation{Jr{FlagPredicate<Flag::zero, true>{}}}
+                    .operation{operate<Jr<FlagPredicate<Flag::zero, true>, i8>>}
                 };
             case 0x29:
                 return {
                     .opcode{opcode}, .name{"ADD HL, HL"}, .duration{2},
-                    .operation{Add<reg16, reg16>{regs.hl, regs.hl}}
+                    .operation{operate<Add<reg16, reg16, RegHL, RegHL>>}
                 };
             case 0x2A:
                 return {
                     .opcode{opcode}, .name{"LD A, (HL+)"}, .duration{2},
-                    .operation{Ldi<reg8, reg16_address>{regs.hl}}
+                    .operation{operate<Ldi<reg8, reg16_address, RegHL>>}
                 };
             case 0x2B:
                 return {
                     .opcode{opcode}, .name{"DEC hl"}, .duration{2},
-                    .operation{Dec<reg16>{regs.hl}}
+                    .operation{operate<Dec<reg16, RegHL>>}
                 };
             case 0x2C:
                 return {
                     .opcode{opcode}, .name{"INC L"}, .duration{1},
-                    .operation{Inc<reg8>{Reg16Low{regs.hl}}}
+                    .operation{operate<Inc<reg8, RegL>>}
                 };
             case 0x2D:
                 return {
                     .opcode{opcode}, .name{"DEC L"}, .duration{1},
-                    .operation{Dec<reg8>{Reg16Low{regs.hl}}}
+                    .operation{operate<Dec<reg8, RegL>>}
                 };
             case 0x2E:
                 return {
                     .opcode{opcode}, .name{"LD L, u8"}, .duration{2},
-                    .operation{Ld<reg8, u8>{Reg16Low{regs.hl}}}
+                    .operation{operate<Ld<reg8, u8, RegL>>}
                 };
             case 0x2F:
                 return {
                     .opcode{opcode}, .name{"CPL"}, .duration{1},
-                    .operation{Cpl{}}
+                    .operation{operate<Cpl>}
                 };
             case 0x30:
                 return {
                     .opcode{opcode}, .name{"JR NC, i8"}, .duration{3},
-                    .operation{Jr{FlagPredicate<Flag::carry, false>{}}}
+                    .operation{operate<Jr<FlagPredicate<Flag::carry, false>, i8>>}
                 };
             case 0x31:
                 return {
                     .opcode{opcode}, .name{"LD SP, u16"}, .duration{3},
-                    .operation{Ld<reg16, u16>{regs.sp}}
+                    .operation{operate<Ld<reg16, u16, RegSP>>}
                 };
             case 0x32:
                 return {
                     .opcode{opcode}, .name{"LD (HL-), A"}, .duration{2},
-                    .operation{Ldd<reg16_address, reg8>{regs.hl}}
+                    .operation{operate<Ldd<reg16_address, reg8, RegHL>>}
                 };
             case 0x33:
                 return {
                     .opcode{opcode}, .name{"INC SP"}, .duration{2},
-                    .operation{Inc<reg16>{regs.sp}}
+                    .operation{operate<Inc<reg16, RegSP>>}
                 };
             case 0x34:
                 return {
                     .opcode{opcode}, .name{"INC (HL)"}, .duration{3},
-                    .operation{Inc<reg16_address>{regs.hl}}
+                    .operation{operate<Inc<reg16_address, RegHL>>}
                 };
             case 0x35:
                 return {
                     .opcode{opcode}, .name{"DEC (HL)"}, .duration{3},
-                    .operation{Dec<reg16_address>{regs.hl}}
+                    .operation{operate<Dec<reg16_address, RegHL>>}
                 };
             case 0x36:
                 return {
                     .opcode{opcode}, .name{"LD (HL), u8"}, .duration{3},
-                    .operation{Ld<reg16_address, u8>{regs.hl}}
+                    .operation{operate<Ld<reg16_address, u8, RegHL>>}
                 };
             case 0x37:
                 return {
                     .opcode{opcode}, .name{"SCF"}, .duration{1},
-                    .operation{Scf{}}
+                    .operation{operate<Scf>}
                 };
             case 0x38:
                 return {
                     .opcode{opcode}, .name{"JR C, i8"}, .duration{3},
-                    .operation{Jr{FlagPredicate<Flag::carry, true>{}}}
+                    .operation{operate<Jr<FlagPredicate<Flag::carry, true>, i8>>}
                 };
             case 0x39:
                 return {
                     .opcode{opcode}, .name{"ADD HL, SP"}, .duration{2},
-                    .operation{Add<reg16, reg16>{regs.hl, regs.sp}}
+                    .operation{operate<Add<reg16, reg16, RegHL, RegSP>>}
                 };
             case 0x3A:
                 return {
                     .opcode{opcode}, .name{"LD A, (HL-)"}, .duration{2},
-                    .operation{Ldd<reg8, reg16_address>{regs.hl}}
+                    .operation{operate<Ldd<reg8, reg16_address, RegHL>>}
                 };
             case 0x3B:
                 return {
                     .opcode{opcode}, .name{"DEC SP"}, .duration{2},
-                    .operation{Dec<reg16>{regs.sp}}
+                    .operation{operate<Dec<reg16, RegSP>>}
                 };
             case 0x3C:
                 return {
                     .opcode{opcode}, .name{"INC A"}, .duration{1},
-                    .operation{Inc<reg8>{Reg16High{regs.af}}}
+                    .operation{operate<Inc<reg8, RegA>>}
                 };
             case 0x3D:
                 return {
                     .opcode{opcode}, .name{"DEC A"}, .duration{1},
-                    .operation{Dec<reg8>{Reg16High{regs.af}}}
+                    .operation{operate<Dec<reg8, RegA>>}
                 };
             case 0x3E:
                 return {
                     .opcode{opcode}, .name{"LD A, u8"}, .duration{2},
-                    .operation{Ld<reg8, u8>{Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg8, u8, RegA>>}
                 };
             case 0x3F:
                 return {
                     .opcode{opcode}, .name{"CCF"}, .duration{1},
-                    .operation{Ccf{}}
+                    .operation{operate<Ccf>}
                 };
             case 0x40:
                 return {
                     .opcode{opcode}, .name{"LD B, B"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.bc}, Reg16High{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegB, RegB>>}
                 };
             case 0x41:
                 return {
                     .opcode{opcode}, .name{"LD B, C"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.bc}, Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegB, RegC>>}
                 };
             case 0x42:
                 return {
                     .opcode{opcode}, .name{"LD B, D"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.bc}, Reg16High{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegB, RegD>>}
                 };
             case 0x43:
                 return {
                     .opcode{opcode}, .name{"LD B, E"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.bc}, Reg16Low{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegB, RegE>>}
                 };
             case 0x44:
                 return {
                     .opcode{opcode}, .name{"LD B, H"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.bc}, Reg16High{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegB, RegH>>}
                 };
             case 0x45:
                 return {
                     .opcode{opcode}, .name{"LD B, L"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.bc}, Reg16Low{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegB, RegL>>}
                 };
             case 0x46:
                 return {
                     .opcode{opcode}, .name{"LD B, (HL)"}, .duration{2},
-                    .operation{Ld<reg8, reg16_address>{Reg16High{regs.bc}, regs.hl}}
+                    .operation{operate<Ld<reg8, reg16_address, RegB, RegHL>>}
                 };
             case 0x47:
                 return {
                     .opcode{opcode}, .name{"LD B, A"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.bc}, Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg8, reg8, RegB, RegA>>}
                 };
             case 0x48:
                 return {
                     .opcode{opcode}, .name{"LD C, B"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.bc}, Reg16High{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegC, RegB>>}
                 };
             case 0x49:
                 return {
                     .opcode{opcode}, .name{"LD C, C"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.bc}, Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegC, RegC>>}
                 };
             case 0x4A:
                 return {
                     .opcode{opcode}, .name{"LD C, D"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.bc}, Reg16High{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegC, RegD>>}
                 };
             case 0x4B:
                 return {
                     .opcode{opcode}, .name{"LD C, E"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.bc}, Reg16Low{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegC, RegE>>}
                 };
             case 0x4C:
                 return {
                     .opcode{opcode}, .name{"LD C, H"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.bc}, Reg16High{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegC, RegH>>}
                 };
             case 0x4D:
                 return {
                     .opcode{opcode}, .name{"LD C, L"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.bc}, Reg16Low{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegC, RegL>>}
                 };
             case 0x4E:
                 return {
                     .opcode{opcode}, .name{"LD C, (HL)"}, .duration{2},
-                    .operation{Ld<reg8, reg16_address>{Reg16Low{regs.bc}, regs.hl}}
+                    .operation{operate<Ld<reg8, reg16_address, RegC, RegHL>>}
                 };
             case 0x4F:
                 return {
                     .opcode{opcode}, .name{"LD C, A"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.bc}, Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg8, reg8, RegC, RegA>>}
                 };
             case 0x50:
                 return {
                     .opcode{opcode}, .name{"LD D, B"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.de}, Reg16High{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegD, RegB>>}
                 };
             case 0x51:
                 return {
                     .opcode{opcode}, .name{"LD D, C"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.de}, Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegD, RegC>>}
                 };
             case 0x52:
                 return {
                     .opcode{opcode}, .name{"LD D, D"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.de}, Reg16High{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegD, RegD>>}
                 };
             case 0x53:
                 return {
                     .opcode{opcode}, .name{"LD D, E"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.de}, Reg16Low{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegD, RegE>>}
                 };
             case 0x54:
                 return {
                     .opcode{opcode}, .name{"LD D, H"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.de}, Reg16High{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegD, RegH>>}
                 };
             case 0x55:
                 return {
                     .opcode{opcode}, .name{"LD D, L"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.de}, Reg16Low{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegD, RegL>>}
                 };
             case 0x56:
                 return {
                     .opcode{opcode}, .name{"LD D, (HL)"}, .duration{2},
-                    .operation{Ld<reg8, reg16_address>{Reg16High{regs.de}, regs.hl}}
+                    .operation{operate<Ld<reg8, reg16_address, RegD, RegHL>>}
                 };
             case 0x57:
                 return {
                     .opcode{opcode}, .name{"LD D, A"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.de}, Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg8, reg8, RegD, RegA>>}
                 };
             case 0x58:
                 return {
                     .opcode{opcode}, .name{"LD E, B"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.de}, Reg16High{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegE, RegB>>}
                 };
             case 0x59:
                 return {
                     .opcode{opcode}, .name{"LD E, C"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.de}, Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegE, RegC>>}
                 };
             case 0x5A:
                 return {
                     .opcode{opcode}, .name{"LD E, D"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.de}, Reg16High{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegE, RegD>>}
                 };
             case 0x5B:
                 return {
                     .opcode{opcode}, .name{"LD E, E"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.de}, Reg16Low{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegE, RegE>>}
                 };
             case 0x5C:
                 return {
                     .opcode{opcode}, .name{"LD E, H"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.de}, Reg16High{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegE, RegH>>}
                 };
             case 0x5D:
                 return {
                     .opcode{opcode}, .name{"LD E, L"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.de}, Reg16Low{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegE, RegL>>}
                 };
             case 0x5E:
                 return {
                     .opcode{opcode}, .name{"LD E, (HL)"}, .duration{2},
-                    .operation{Ld<reg8, reg16_address>{Reg16Low{regs.de}, regs.hl}}
+                    .operation{operate<Ld<reg8, reg16_address, RegE, RegHL>>}
                 };
             case 0x5F:
                 return {
                     .opcode{opcode}, .name{"LD E, A"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.de}, Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg8, reg8, RegE, RegA>>}
                 };
             case 0x60:
                 return {
                     .opcode{opcode}, .name{"LD H, B"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.hl}, Reg16High{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegH, RegB>>}
                 };
             case 0x61:
                 return {
                     .opcode{opcode}, .name{"LD H, C"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.hl}, Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegH, RegC>>}
                 };
             case 0x62:
                 return {
                     .opcode{opcode}, .name{"LD H, D"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.hl}, Reg16High{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegH, RegD>>}
                 };
             case 0x63:
                 return {
                     .opcode{opcode}, .name{"LD H, E"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.hl}, Reg16Low{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegH, RegE>>}
                 };
             case 0x64:
                 return {
                     .opcode{opcode}, .name{"LD H, H"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.hl}, Reg16High{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegH, RegH>>}
                 };
             case 0x65:
                 return {
                     .opcode{opcode}, .name{"LD H, L"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.hl}, Reg16Low{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegH, RegL>>}
                 };
             case 0x66:
                 return {
                     .opcode{opcode}, .name{"LD H, (HL)"}, .duration{2},
-                    .operation{Ld<reg8, reg16_address>{Reg16High{regs.hl}, regs.hl}}
+                    .operation{operate<Ld<reg8, reg16_address, RegH, RegHL>>}
                 };
             case 0x67:
                 return {
                     .opcode{opcode}, .name{"LD H, A"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.hl}, Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg8, reg8, RegH, RegA>>}
                 };
             case 0x68:
                 return {
                     .opcode{opcode}, .name{"LD L, B"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.hl}, Reg16High{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegL, RegB>>}
                 };
             case 0x69:
                 return {
                     .opcode{opcode}, .name{"LD L, C"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.hl}, Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegL, RegC>>}
                 };
             case 0x6A:
                 return {
                     .opcode{opcode}, .name{"LD L, D"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.hl}, Reg16High{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegL, RegD>>}
                 };
             case 0x6B:
                 return {
                     .opcode{opcode}, .name{"LD L, E"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.hl}, Reg16Low{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegL, RegE>>}
                 };
             case 0x6C:
                 return {
                     .opcode{opcode}, .name{"LD L, H"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.hl}, Reg16High{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegL, RegH>>}
                 };
             case 0x6D:
                 return {
                     .opcode{opcode}, .name{"LD L, L"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.hl}, Reg16Low{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegL, RegL>>}
                 };
             case 0x6E:
                 return {
                     .opcode{opcode}, .name{"LD L, (HL)"}, .duration{2},
-                    .operation{Ld<reg8, reg16_address>{Reg16Low{regs.hl}, regs.hl}}
+                    .operation{operate<Ld<reg8, reg16_address, RegL, RegHL>>}
                 };
             case 0x6F:
                 return {
                     .opcode{opcode}, .name{"LD L, A"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16Low{regs.hl}, Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg8, reg8, RegL, RegA>>}
                 };
             case 0x70:
                 return {
                     .opcode{opcode}, .name{"LD (HL), B"}, .duration{2},
-                    .operation{Ld<reg16_address, reg8>{regs.hl, Reg16High{regs.bc}}}
+                    .operation{operate<Ld<reg16_address, reg8, RegHL, RegB>>}
                 };
             case 0x71:
                 return {
                     .opcode{opcode}, .name{"LD (HL), C"}, .duration{2},
-                    .operation{Ld<reg16_address, reg8>{regs.hl, Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg16_address, reg8, RegHL, RegC>>}
                 };
             case 0x72:
                 return {
                     .opcode{opcode}, .name{"LD (HL), D"}, .duration{2},
-                    .operation{Ld<reg16_address, reg8>{regs.hl, Reg16High{regs.de}}}
+                    .operation{operate<Ld<reg16_address, reg8, RegHL, RegD>>}
                 };
             case 0x73:
                 return {
                     .opcode{opcode}, .name{"LD (HL), E"}, .duration{2},
-                    .operation{Ld<reg16_address, reg8>{regs.hl, Reg16Low{regs.de}}}
+                    .operation{operate<Ld<reg16_address, reg8, RegHL, RegE>>}
                 };
             case 0x74:
                 return {
                     .opcode{opcode}, .name{"LD (HL), H"}, .duration{2},
-                    .operation{Ld<reg16_address, reg8>{regs.hl, Reg16High{regs.hl}}}
+                    .operation{operate<Ld<reg16_address, reg8, RegHL, RegH>>}
                 };
             case 0x75:
                 return {
                     .opcode{opcode}, .name{"LD (HL), L"}, .duration{2},
-                    .operation{Ld<reg16_address, reg8>{regs.hl, Reg16Low{regs.hl}}}
+                    .operation{operate<Ld<reg16_address, reg8, RegHL, RegL>>}
                 };
             case 0x76:
                 return {
                     .opcode{opcode}, .name{"HALT"}, .duration{1},
-                    .operation{Halt{}}
+                    .operation{operate<Halt>}
                 };
             case 0x77:
                 return {
                     .opcode{opcode}, .name{"LD (HL), A"}, .duration{2},
-                    .operation{Ld<reg16_address, reg8>{regs.hl, Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg16_address, reg8, RegHL, RegA>>}
                 };
             case 0x78:
                 return {
                     .opcode{opcode}, .name{"LD A, B"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.af}, Reg16High{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegA, RegB>>}
                 };
             case 0x79:
                 return {
                     .opcode{opcode}, .name{"LD A, C"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.af}, Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8, RegA, RegC>>}
                 };
             case 0x7A:
                 return {
                     .opcode{opcode}, .name{"LD A, D"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.af}, Reg16High{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegA, RegD>>}
                 };
             case 0x7B:
                 return {
                     .opcode{opcode}, .name{"LD A, E"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.af}, Reg16Low{regs.de}}}
+                    .operation{operate<Ld<reg8, reg8, RegA, RegE>>}
                 };
             case 0x7C:
                 return {
                     .opcode{opcode}, .name{"LD A, H"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.af}, Reg16High{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegA, RegH>>}
                 };
             case 0x7D:
                 return {
                     .opcode{opcode}, .name{"LD A, L"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.af}, Reg16Low{regs.hl}}}
+                    .operation{operate<Ld<reg8, reg8, RegA, RegL>>}
                 };
             case 0x7E:
                 return {
                     .opcode{opcode}, .name{"LD A, (HL)"}, .duration{2},
-                    .operation{Ld<reg8, reg16_address>{Reg16High{regs.af}, regs.hl}}
+                    .operation{operate<Ld<reg8, reg16_address, RegA, RegHL>>}
                 };
             case 0x7F:
                 return {
                     .opcode{opcode}, .name{"LD A, A"}, .duration{1},
-                    .operation{Ld<reg8, reg8>{Reg16High{regs.af}, Reg16High{regs.af}}}
+                    .operation{operate<Ld<reg8, reg8, RegA, RegA>>}
                 };
             case 0x80:
                 return {
                     .opcode{opcode}, .name{"ADD A, B"}, .duration{1},
-                    .operation{Add<reg8, reg8>{Reg16High{regs.bc}}}
+                    .operation{operate<Add<reg8, reg8, RegB>>}
                 };
             case 0x81:
                 return {
                     .opcode{opcode}, .name{"ADD A, C"}, .duration{1},
-                    .operation{Add<reg8, reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Add<reg8, reg8, RegC>>}
                 };
             case 0x82:
                 return {
                     .opcode{opcode}, .name{"ADD A, D"}, .duration{1},
-                    .operation{Add<reg8, reg8>{Reg16High{regs.de}}}
+                    .operation{operate<Add<reg8, reg8, RegD>>}
                 };
             case 0x83:
                 return {
                     .opcode{opcode}, .name{"ADD A, E"}, .duration{1},
-                    .operation{Add<reg8, reg8>{Reg16Low{regs.de}}}
+                    .operation{operate<Add<reg8, reg8, RegE>>}
                 };
             case 0x84:
                 return {
                     .opcode{opcode}, .name{"ADD A, H"}, .duration{1},
-                    .operation{Add<reg8, reg8>{Reg16High{regs.hl}}}
+                    .operation{operate<Add<reg8, reg8, RegH>>}
                 };
             case 0x85:
                 return {
                     .opcode{opcode}, .name{"ADD A, L"}, .duration{1},
-                    .operation{Add<reg8, reg8>{Reg16Low{regs.hl}}}
+                    .operation{operate<Add<reg8, reg8, RegL>>}
                 };
             case 0x86:
                 return {
                     .opcode{opcode}, .name{"ADD A, (HL)"}, .duration{2},
-                    .operation{Add<reg8, reg16_address>{regs.hl}}
+                    .operation{operate<Add<reg8, reg16_address, RegHL>>}
                 };
             case 0x87:
                 return {
                     .opcode{opcode}, .name{"ADD A, A"}, .duration{1},
-                    .operation{Add<reg8, reg8>{Reg16High{regs.af}}}
+                    .operation{operate<Add<reg8, reg8, RegA>>}
                 };
             case 0x88:
                 return {
                     .opcode{opcode}, .name{"ADC A, B"}, .duration{1},
-                    .operation{Adc<reg8, reg8>{Reg16High{regs.bc}}}
+                    .operation{operate<Adc<reg8, reg8, RegB>>}
                 };
             case 0x89:
                 return {
                     .opcode{opcode}, .name{"ADC A, C"}, .duration{1},
-                    .operation{Adc<reg8, reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Adc<reg8, reg8, RegC>>}
                 };
             case 0x8A:
                 return {
                     .opcode{opcode}, .name{"ADC A, D"}, .duration{1},
-                    .operation{Adc<reg8, reg8>{Reg16High{regs.de}}}
+                    .operation{operate<Adc<reg8, reg8, RegD>>}
                 };
             case 0x8B:
                 return {
                     .opcode{opcode}, .name{"ADC A, E"}, .duration{1},
-                    .operation{Adc<reg8, reg8>{Reg16Low{regs.de}}}
+                    .operation{operate<Adc<reg8, reg8, RegE>>}
                 };
             case 0x8C:
                 return {
                     .opcode{opcode}, .name{"ADC A, H"}, .duration{1},
-                    .operation{Adc<reg8, reg8>{Reg16High{regs.hl}}}
+                    .operation{operate<Adc<reg8, reg8, RegH>>}
                 };
             case 0x8D:
                 return {
                     .opcode{opcode}, .name{"ADC A, L"}, .duration{1},
-                    .operation{Adc<reg8, reg8>{Reg16Low{regs.hl}}}
+                    .operation{operate<Adc<reg8, reg8, RegL>>}
                 };
             case 0x8E:
                 return {
                     .opcode{opcode}, .name{"ADC A, (HL)"}, .duration{2},
-                    .operation{Adc<reg8, reg16_address>{regs.hl}}
+                    .operation{operate<Adc<reg8, reg16_address, RegHL>>}
                 };
             case 0x8F:
                 return {
                     .opcode{opcode}, .name{"ADC A, A"}, .duration{1},
-                    .operation{Adc<reg8, reg8>{Reg16High{regs.af}}}
+                    .operation{operate<Adc<reg8, reg8, RegA>>}
                 };
             case 0x90:
                 return {
                     .opcode{opcode}, .name{"SUB A, B"}, .duration{1},
-                    .operation{Sub<reg8, reg8>{Reg16High{regs.bc}}}
+                    .operation{operate<Sub<reg8, reg8, RegB>>}
                 };
             case 0x91:
                 return {
                     .opcode{opcode}, .name{"SUB A, C"}, .duration{1},
-                    .operation{Sub<reg8, reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Sub<reg8, reg8, RegC>>}
                 };
             case 0x92:
                 return {
                     .opcode{opcode}, .name{"SUB A, D"}, .duration{1},
-                    .operation{Sub<reg8, reg8>{Reg16High{regs.de}}}
+                    .operation{operate<Sub<reg8, reg8, RegD>>}
                 };
             case 0x93:
                 return {
                     .opcode{opcode}, .name{"SUB A, E"}, .duration{1},
-                    .operation{Sub<reg8, reg8>{Reg16Low{regs.de}}}
+                    .operation{operate<Sub<reg8, reg8, RegE>>}
                 };
             case 0x94:
                 return {
                     .opcode{opcode}, .name{"SUB A, H"}, .duration{1},
-                    .operation{Sub<reg8, reg8>{Reg16High{regs.hl}}}
+                    .operation{operate<Sub<reg8, reg8, RegH>>}
                 };
             case 0x95:
                 return {
                     .opcode{opcode}, .name{"SUB A, L"}, .duration{1},
-                    .operation{Sub<reg8, reg8>{Reg16Low{regs.hl}}}
+                    .operation{operate<Sub<reg8, reg8, RegL>>}
                 };
             case 0x96:
                 return {
                     .opcode{opcode}, .name{"SUB A, (HL)"}, .duration{2},
-                    .operation{Sub<reg8, reg16_address>{regs.hl}}
+                    .operation{operate<Sub<reg8, reg16_address, RegHL>>}
                 };
             case 0x97:
                 return {
                     .opcode{opcode}, .name{"SUB A, A"}, .duration{1},
-                    .operation{Sub<reg8, reg8>{Reg16High{regs.af}}}
+                    .operation{operate<Sub<reg8, reg8, RegA>>}
                 };
             case 0x98:
                 return {
                     .opcode{opcode}, .name{"SBC A, B"}, .duration{1},
-                    .operation{Sbc<reg8, reg8>{Reg16High{regs.bc}}}
+                    .operation{operate<Sbc<reg8, reg8, RegB>>}
                 };
             case 0x99:
                 return {
                     .opcode{opcode}, .name{"SBC A, C"}, .duration{1},
-                    .operation{Sbc<reg8, reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Sbc<reg8, reg8, RegC>>}
                 };
             case 0x9A:
                 return {
                     .opcode{opcode}, .name{"SBC A, D"}, .duration{1},
-                    .operation{Sbc<reg8, reg8>{Reg16High{regs.de}}}
+                    .operation{operate<Sbc<reg8, reg8, RegD>>}
                 };
             case 0x9B:
                 return {
                     .opcode{opcode}, .name{"SBC A, E"}, .duration{1},
-                    .operation{Sbc<reg8, reg8>{Reg16Low{regs.de}}}
+                    .operation{operate<Sbc<reg8, reg8, RegE>>}
                 };
             case 0x9C:
                 return {
                     .opcode{opcode}, .name{"SBC A, H"}, .duration{1},
-                    .operation{Sbc<reg8, reg8>{Reg16High{regs.hl}}}
+                    .operation{operate<Sbc<reg8, reg8, RegH>>}
                 };
             case 0x9D:
                 return {
                     .opcode{opcode}, .name{"SBC A, L"}, .duration{1},
-                    .operation{Sbc<reg8, reg8>{Reg16Low{regs.hl}}}
+                    .operation{operate<Sbc<reg8, reg8, RegL>>}
                 };
             case 0x9E:
                 return {
                     .opcode{opcode}, .name{"SBC A, (HL)"}, .duration{2},
-                    .operation{Sbc<reg8, reg16_address>{regs.hl}}
+                    .operation{operate<Sbc<reg8, reg16_address, RegHL>>}
                 };
             case 0x9F:
                 return {
                     .opcode{opcode}, .name{"SBC A, A"}, .duration{1},
-                    .operation{Sbc<reg8, reg8>{Reg16High{regs.af}}}
+                    .operation{operate<Sbc<reg8, reg8, RegA>>}
                 };
             case 0xA0:
                 return {
                     .opcode{opcode}, .name{"AND A, B"}, .duration{1},
-                    .operation{And<reg8, reg8>{Reg16High{regs.bc}}}
+                    .operation{operate<And<reg8, reg8, RegB>>}
                 };
             case 0xA1:
                 return {
                     .opcode{opcode}, .name{"AND A, C"}, .duration{1},
-                    .operation{And<reg8, reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<And<reg8, reg8, RegC>>}
                 };
             case 0xA2:
                 return {
                     .opcode{opcode}, .name{"AND A, D"}, .duration{1},
-                    .operation{And<reg8, reg8>{Reg16High{regs.de}}}
+                    .operation{operate<And<reg8, reg8, RegD>>}
                 };
             case 0xA3:
                 return {
                     .opcode{opcode}, .name{"AND A, E"}, .duration{1},
-                    .operation{And<reg8, reg8>{Reg16Low{regs.de}}}
+                    .operation{operate<And<reg8, reg8, RegE>>}
                 };
             case 0xA4:
                 return {
                     .opcode{opcode}, .name{"AND A, H"}, .duration{1},
-                    .operation{And<reg8, reg8>{Reg16High{regs.hl}}}
+                    .operation{operate<And<reg8, reg8, RegH>>}
                 };
             case 0xA5:
                 return {
                     .opcode{opcode}, .name{"AND A, L"}, .duration{1},
-                    .operation{And<reg8, reg8>{Reg16Low{regs.hl}}}
+                    .operation{operate<And<reg8, reg8, RegL>>}
                 };
             case 0xA6:
                 return {
                     .opcode{opcode}, .name{"AND A, (HL)"}, .duration{1},
-                    .operation{And<reg8, reg16_address>{regs.hl}}
+                    .operation{operate<And<reg8, reg16_address, RegHL>>}
                 };
             case 0xA7:
                 return {
                     .opcode{opcode}, .name{"AND A, A"}, .duration{1},
-                    .operation{And<reg8, reg8>{Reg16High{regs.af}}}
+                    .operation{operate<And<reg8, reg8, RegA>>}
                 };
             case 0xA8:
                 return {
                     .opcode{opcode}, .name{"XOR A, B"}, .duration{1},
-                    .operation{Xor<reg8, reg8>{Reg16High{regs.bc}}}
+                    .operation{operate<Xor<reg8, reg8, RegB>>}
                 };
             case 0xA9:
                 return {
                     .opcode{opcode}, .name{"XOR A, C"}, .duration{1},
-                    .operation{Xor<reg8, reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Xor<reg8, reg8, RegC>>}
                 };
             case 0xAA:
                 return {
                     .opcode{opcode}, .name{"XOR A, D"}, .duration{1},
-                    .operation{Xor<reg8, reg8>{Reg16High{regs.de}}}
+                    .operation{operate<Xor<reg8, reg8, RegD>>}
                 };
             case 0xAB:
                 return {
                     .opcode{opcode}, .name{"XOR A, E"}, .duration{1},
-                    .operation{Xor<reg8, reg8>{Reg16Low{regs.de}}}
+                    .operation{operate<Xor<reg8, reg8, RegE>>}
                 };
             case 0xAC:
                 return {
                     .opcode{opcode}, .name{"XOR A, H"}, .duration{1},
-                    .operation{Xor<reg8, reg8>{Reg16High{regs.hl}}}
+                    .operation{operate<Xor<reg8, reg8, RegH>>}
                 };
             case 0xAD:
                 return {
                     .opcode{opcode}, .name{"XOR A, L"}, .duration{1},
-                    .operation{Xor<reg8, reg8>{Reg16Low{regs.hl}}}
+                    .operation{operate<Xor<reg8, reg8, RegL>>}
                 };
             case 0xAE:
                 return {
                     .opcode{opcode}, .name{"XOR A, (HL)"}, .duration{1},
-                    .operation{Xor<reg8, reg16_address>{regs.hl}}
+                    .operation{operate<Xor<reg8, reg16_address, RegHL>>}
                 };
             case 0xAF:
                 return {
                     .opcode{opcode}, .name{"XOR A, A"}, .duration{1},
-                    .operation{Xor<reg8, reg8>{Reg16High{regs.af}}}
+                    .operation{operate<Xor<reg8, reg8, RegA>>}
                 };
             case 0xB0:
                 return {
                     .opcode{opcode}, .name{"OR A, B"}, .duration{1},
-                    .operation{Or<reg8, reg8>{Reg16High{regs.bc}}}
+                    .operation{operate<Or<reg8, reg8, RegB>>}
                 };
             case 0xB1:
                 return {
                     .opcode{opcode}, .name{"OR A, C"}, .duration{1},
-                    .operation{Or<reg8, reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Or<reg8, reg8, RegC>>}
                 };
             case 0xB2:
                 return {
                     .opcode{opcode}, .name{"OR A, D"}, .duration{1},
-                    .operation{Or<reg8, reg8>{Reg16High{regs.de}}}
+                    .operation{operate<Or<reg8, reg8, RegD>>}
                 };
             case 0xB3:
                 return {
                     .opcode{opcode}, .name{"OR A, E"}, .duration{1},
-                    .operation{Or<reg8, reg8>{Reg16Low{regs.de}}}
+                    .operation{operate<Or<reg8, reg8, RegE>>}
                 };
             case 0xB4:
                 return {
                     .opcode{opcode}, .name{"OR A, H"}, .duration{1},
-                    .operation{Or<reg8, reg8>{Reg16High{regs.hl}}}
+                    .operation{operate<Or<reg8, reg8, RegH>>}
                 };
             case 0xB5:
                 return {
                     .opcode{opcode}, .name{"OR A, L"}, .duration{1},
-                    .operation{Or<reg8, reg8>{Reg16Low{regs.hl}}}
+                    .operation{operate<Or<reg8, reg8, RegL>>}
                 };
             case 0xB6:
                 return {
                     .opcode{opcode}, .name{"OR A, (HL)"}, .duration{1},
-                    .operation{Or<reg8, reg16_address>{regs.hl}}
+                    .operation{operate<Or<reg8, reg16_address, RegHL>>}
                 };
             case 0xB7:
                 return {
                     .opcode{opcode}, .name{"OR A, A"}, .duration{1},
-                    .operation{Or<reg8, reg8>{Reg16High{regs.af}}}
+                    .operation{operate<Or<reg8, reg8, RegA>>}
                 };
             case 0xB8:
                 return {
                     .opcode{opcode}, .name{"CP A, B"}, .duration{1},
-                    .operation{Cp<reg8, reg8>{Reg16High{regs.bc}}}
+                    .operation{operate<Cp<reg8, reg8, RegB>>}
                 };
             case 0xB9:
                 return {
                     .opcode{opcode}, .name{"CP A, C"}, .duration{1},
-                    .operation{Cp<reg8, reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Cp<reg8, reg8, RegC>>}
                 };
             case 0xBA:
                 return {
                     .opcode{opcode}, .name{"CP A, D"}, .duration{1},
-                    .operation{Cp<reg8, reg8>{Reg16High{regs.de}}}
+                    .operation{operate<Cp<reg8, reg8, RegD>>}
                 };
             case 0xBB:
                 return {
                     .opcode{opcode}, .name{"CP A, E"}, .duration{1},
-                    .operation{Cp<reg8, reg8>{Reg16Low{regs.de}}}
+                    .operation{operate<Cp<reg8, reg8, RegE>>}
                 };
             case 0xBC:
                 return {
                     .opcode{opcode}, .name{"CP A, H"}, .duration{1},
-                    .operation{Cp<reg8, reg8>{Reg16High{regs.hl}}}
+                    .operation{operate<Cp<reg8, reg8, RegH>>}
                 };
             case 0xBD:
                 return {
                     .opcode{opcode}, .name{"CP A, L"}, .duration{1},
-                    .operation{Cp<reg8, reg8>{Reg16Low{regs.hl}}}
+                    .operation{operate<Cp<reg8, reg8, RegL>>}
                 };
             case 0xBE:
                 return {
                     .opcode{opcode}, .name{"CP A, (HL)"}, .duration{1},
-                    .operation{Cp<reg8, reg16_address>{regs.hl}}
+                    .operation{operate<Cp<reg8, reg16_address, RegHL>>}
                 };
             case 0xBF:
                 return {
                     .opcode{opcode}, .name{"CP A, A"}, .duration{1},
-                    .operation{Cp<reg8, reg8>{Reg16High{regs.af}}}
+                    .operation{operate<Cp<reg8, reg8, RegA>>}
                 };
             case 0xC0:
                 return {
                     .opcode{opcode}, .name{"RET NZ"}, .duration{5},
-                    .operation{Ret{FlagPredicate<Flag::zero, false>{}}}
+                    .operation{operate<Ret<FlagPredicate<Flag::zero, false>>>}
                 };
             case 0xC1:
                 return {
                     .opcode{opcode}, .name{"POP BC"}, .duration{3},
-                    .operation{Pop<without_flag>{regs.bc}}
+                    .operation{operate<Pop<without_flag, RegBC>>}
                 };
             case 0xC2:
                 return {
                     .opcode{opcode}, .name{"JP NZ, u16"}, .duration{4},
-                    .operation{Jp{FlagPredicate<Flag::zero, false>{}}}
+                    .operation{operate<Jp<FlagPredicate<Flag::zero, false>, u16>>}
                 };
             case 0xC3:
                 return {
                     .opcode{opcode}, .name{"JP u16"}, .duration{4},
-                    .operation{Jp{}}
+                    .operation{operate<Jp<void, u16>>}
                 };
             case 0xC4:
                 return {
                     .opcode{opcode}, .name{"CALL NZ, u16"}, .duration{6},
-                    .operation{Call{FlagPredicate<Flag::zero, false>{}}}
+                    .operation{operate<Call<FlagPredicate<Flag::zero, false>, u16>>}
                 };
             case 0xC5:
                 return {
                     .opcode{opcode}, .name{"PUSH BC"}, .duration{4},
-                    .operation{Push<without_flag>{regs.bc}}
+                    .operation{operate<Push<without_flag, RegBC>>}
                 };
             case 0xC6:
                 return {
                     .opcode{opcode}, .name{"ADD A, u8"}, .duration{2},
-                    .operation{Add<reg8, u8>{}}
+                    .operation{operate<Add<reg8, u8>>}
                 };
             case 0xC7:
                 return {
                     .opcode{opcode}, .name{"RST 00h"}, .duration{4},
-                    .operation{Rst<0x00>{}}
+                    .operation{operate<Rst<0x00>>}
                 };
             case 0xC8:
                 return {
                     .opcode{opcode}, .name{"RET Z"}, .duration{5},
-                    .operation{Ret{FlagPredicate<Flag::zero, true>{}}}
+                    .operation{operate<Ret<FlagPredicate<Flag::zero, true>>>}
                 };
             case 0xC9:
                 return {
                     .opcode{opcode}, .name{"RET"}, .duration{4},
-                    .operation{Ret{}}
+                    .operation{operate<Ret<void>>}
                 };
             case 0xCA:
                 return {
                     .opcode{opcode}, .name{"JP Z, u16"}, .duration{4},
-                    .operation{Jp{FlagPredicate<Flag::zero, true>{}}}
+                    .operation{operate<Jp<FlagPredicate<Flag::zero, true>, u16>>}
                 };
             case 0xCB:
                 return {
                     .opcode{opcode}, .name{"PREFIX"}, .duration{1},
-                    .operation{[this] (int, Registers&, gameboy::io::Bus&) -> auto { return this->resolve_prefixed_instruction(); }}
+                    .operation{operate<Prefix>}
                 };
             case 0xCC:
                 return {
                     .opcode{opcode}, .name{"CALL Z, u16"}, .duration{6},
-                    .operation{Call{FlagPredicate<Flag::zero, true>{}}}
+                    .operation{operate<Call<FlagPredicate<Flag::zero, true>, u16>>}
                 };
             case 0xCD:
                 return {
                     .opcode{opcode}, .name{"CALL u16"}, .duration{6},
-                    .operation{Call{}}
+                    .operation{operate<Call<void, u16>>}
                 };
             case 0xCE:
                 return {
                     .opcode{opcode}, .name{"ADC A, u8"}, .duration{2},
-                    .operation{Adc<reg8, u8>{}}
+                    .operation{operate<Adc<reg8, u8>>}
                 };
             case 0xCF:
                 return {
                     .opcode{opcode}, .name{"RST 08h"}, .duration{4},
-                    .operation{Rst<0x08>{}}
+                    .operation{operate<Rst<0x08>>}
                 };
             case 0xD0:
                 return {
                     .opcode{opcode}, .name{"RET NC"}, .duration{5},
-                    .operation{Ret{FlagPredicate<Flag::carry, false>{}}}
+                    .operation{operate<Ret<FlagPredicate<Flag::carry, false>>>}
                 };
             case 0xD1:
                 return {
                     .opcode{opcode}, .name{"POP DE"}, .duration{3},
-                    .operation{Pop<without_flag>{regs.de}}
+                    .operation{operate<Pop<without_flag, RegDE>>}
                 };
             case 0xD2:
                 return {
                     .opcode{opcode}, .name{"JP NC, u16"}, .duration{4},
-                    .operation{Jp{FlagPredicate<Flag::carry, false>{}}}
+                    .operation{operate<Jp<FlagPredicate<Flag::carry, false>, u16>>}
                 };
             case 0xD4:
                 return {
                     .opcode{opcode}, .name{"CALL NC, u16"}, .duration{6},
-                    .operation{Call{FlagPredicate<Flag::carry, false>{}}}
+                    .operation{operate<Call<FlagPredicate<Flag::carry, false>, u16>>}
                 };
             case 0xD5:
                 return {
                     .opcode{opcode}, .name{"PUSH DE"}, .duration{4},
-                    .operation{Push<without_flag>{regs.de}}
+                    .operation{operate<Push<without_flag, RegDE>>}
                 };
             case 0xD6:
                 return {
                     .opcode{opcode}, .name{"SUB A, u8"}, .duration{2},
-                    .operation{Sub<reg8, u8>{}}
+                    .operation{operate<Sub<reg8, u8>>}
                 };
             case 0xD7:
                 return {
                     .opcode{opcode}, .name{"RST 10h"}, .duration{4},
-                    .operation{Rst<0x10>{}}
+                    .operation{operate<Rst<0x10>>}
                 };
             case 0xD8:
                 return {
                     .opcode{opcode}, .name{"RET C"}, .duration{5},
-                    .operation{Ret{FlagPredicate<Flag::carry, true>{}}}
+                    .operation{operate<Ret<FlagPredicate<Flag::carry, true>>>}
                 };
             case 0xD9:
                 return {
                     .opcode{opcode}, .name{"RETI"}, .duration{4},
-                    .operation{Reti{}}
+                    .operation{operate<Reti>}
                 };
             case 0xDA:
                 return {
                     .opcode{opcode}, .name{"JP C, u16"}, .duration{4},
-                    .operation{Jp{FlagPredicate<Flag::carry, true>{}}}
+                    .operation{operate<Jp<FlagPredicate<Flag::carry, true>, u16>>}
                 };
             case 0xDC:
                 return {
                     .opcode{opcode}, .name{"CALL C, u16"}, .duration{6},
-                    .operation{Call{FlagPredicate<Flag::carry, true>{}}}
+                    .operation{operate<Call<FlagPredicate<Flag::carry, true>, u16>>}
                 };
             case 0xDE:
                 return {
                     .opcode{opcode}, .name{"SBC A, u8"}, .duration{2},
-                    .operation{Sbc<reg8, u8>{}}
+                    .operation{operate<Sbc<reg8, u8>>}
                 };
             case 0xDF:
                 return {
                     .opcode{opcode}, .name{"RST 18h"}, .duration{4},
-                    .operation{Rst<0x18>{}}
+                    .operation{operate<Rst<0x18>>}
                 };
             case 0xE0:
                 return {
                     .opcode{opcode}, .name{"LD (FF00 + u8), A"}, .duration{3},
-                    .operation{Ld<u8_address, reg8>{}}
+                    .operation{operate<Ld<u8_address, reg8>>}
                 };
             case 0xE1:
                 return {
                     .opcode{opcode}, .name{"POP HL"}, .duration{3},
-                    .operation{Pop<without_flag>{regs.hl}}
+                    .operation{operate<Pop<without_flag, RegHL>>}
                 };
             case 0xE2:
                 return {
                     .opcode{opcode}, .name{"LD (FF00 + C), A"}, .duration{2},
-                    .operation{Ld<reg8_address, reg8>{Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg8_address, reg8, RegC>>}
                 };
             case 0xE5:
                 return {
                     .opcode{opcode}, .name{"PUSH HL"}, .duration{4},
-                    .operation{Push<without_flag>{regs.hl}}
+                    .operation{operate<Push<without_flag, RegHL>>}
                 };
             case 0xE6:
                 return {
                     .opcode{opcode}, .name{"AND A, u8"}, .duration{2},
-                    .operation{And<reg8, u8>{}}
+                    .operation{operate<And<reg8, u8>>}
                 };
             case 0xE7:
                 return {
                     .opcode{opcode}, .name{"RST 20h"}, .duration{4},
-                    .operation{Rst<0x20>{}}
+                    .operation{operate<Rst<0x20>>}
                 };
             case 0xE8:
                 return {
                     .opcode{opcode}, .name{"ADD SP, i8"}, .duration{4},
-                    .operation{Add<reg16, i8>{regs.sp}}
+                    .operation{operate<Add<reg16, i8, RegSP>>}
                 };
             case 0xE9:
                 return {
                     .opcode{opcode}, .name{"JP HL"}, .duration{1},
-                    .operation{Jp{regs.hl}}
+                    .operation{operate<Jp<void, reg16, RegHL>>}
                 };
             case 0xEA:
                 return {
                     .opcode{opcode}, .name{"LD (u16), A"}, .duration{4},
-                    .operation{Ld<u16_address, reg8>{}}
+                    .operation{operate<Ld<u16_address, reg8>>}
                 };
             case 0xEE:
                 return {
                     .opcode{opcode}, .name{"XOR A, u8"}, .duration{2},
-                    .operation{Xor<reg8, u8>{}}
+                    .operation{operate<Xor<reg8, u8>>}
                 };
             case 0xEF:
                 return {
                     .opcode{opcode}, .name{"RST 28h"}, .duration{4},
-                    .operation{Rst<0x28>{}}
+                    .operation{operate<Rst<0x28>>}
                 };
             case 0xF0:
                 return {
                     .opcode{opcode}, .name{"LD A, (FF00 + u8)"}, .duration{3},
-                    .operation{Ld<reg8, u8_address>{}}
+                    .operation{operate<Ld<reg8, u8_address>>}
                 };
             case 0xF1:
                 return {
                     .opcode{opcode}, .name{"POP AF"}, .duration{3},
-                    .operation{Pop<with_flag>{regs.af}}
+                    .operation{operate<Pop<with_flag, RegAF>>}
                 };
             case 0xF2:
                 return {
                     .opcode{opcode}, .name{"LD A, (FF00 + C)"}, .duration{2},
-                    .operation{Ld<reg8, reg8_address>{Reg16Low{regs.bc}}}
+                    .operation{operate<Ld<reg8, reg8_address, RegC>>}
                 };
             case 0xF3:
                 return {
                     .opcode{opcode}, .name{"DI"}, .duration{1},
-                    .operation{Di{}}
+                    .operation{operate<Di>}
                 };
             case 0xF5:
                 return {
                     .opcode{opcode}, .name{"PUSH AF"}, .duration{4},
-                    .operation{Push<with_flag>{regs.af}}
+                    .operation{operate<Push<with_flag, RegAF>>}
                 };
             case 0xF6:
                 return {
                     .opcode{opcode}, .name{"OR A, u8"}, .duration{2},
-                    .operation{Or<reg8, u8>{}}
+                    .operation{operate<Or<reg8, u8>>}
                 };
             case 0xF7:
                 return {
                     .opcode{opcode}, .name{"RST 30h"}, .duration{4},
-                    .operation{Rst<0x30>{}}
+                    .operation{operate<Rst<0x30>>}
                 };
             case 0xF8:
                 return {
                     .opcode{opcode}, .name{"LD HL, SP + i8"}, .duration{3},
-                    .operation{Ld<reg16, reg16_offset>{regs.hl, regs.sp}}
+                    .operation{operate<Ld<reg16, reg16_offset, RegHL, RegSP>>}
                 };
             case 0xF9:
                 return {
                     .opcode{opcode}, .name{"LD SP, HL"}, .duration{2},
-                    .operation{Ld<reg16, reg16>{regs.sp, regs.hl}}
+                    .operation{operate<Ld<reg16, reg16, RegSP, RegHL>>}
                 };
             case 0xFA:
                 return {
                     .opcode{opcode}, .name{"LD A, (u16)"}, .duration{4},
-                    .operation{Ld<reg8, u16_address>{}}
+                    .operation{operate<Ld<reg8, u16_address>>}
                 };
             case 0xFB:
                 return {
                     .opcode{opcode}, .name{"EI"}, .duration{1},
-                    .operation{Ei{}}
+                    .operation{operate<Ei>}
                 };
             case 0xFE:
                 return {
                     .opcode{opcode}, .name{"CP A, u8"}, .duration{2},
-                    .operation{Cp<reg8, u8>{}}
+                    .operation{operate<Cp<reg8, u8>>}
                 };
             case 0xFF:
                 return {
                     .opcode{opcode}, .name{"RST 38h"}, .duration{4},
-                    .operation{Rst<0x38>{}}
-                };
-        }
-    }
-
-    void Core::execute(const Instruction::Operation& func)
-    {
-        Instruction::SideEffect result{func(m_cycle++, regs, *p_bus)};
-        m_cycle += result.cycle_adjustment;
-
-        if (result.ime_adjustment.has_value()) {
-            interrupt_master_enable = *result.ime_adjustment;
-        }
-
-        if (result.halt_attempt.has_value()) {
-            if (result.halt_attempt->success) {
-                instruction = {
-                    .opcode{}, .name{"HALTED"}, .duration{1},
-                    .operation{halting}
+                    .operation{operate<Rst<0x38>>}
                 };
-            }
-            else {
-                instruction = decode(p_bus->read_byte(regs.program_counter));
-            }
         }
     }
 
-    Instruction::SideEffect Core::resolve_prefixed_instruction()
+    constexpr Instruction decode_prefixed(int opcode)
     {
-        auto opcode{p_bus->read_byte(regs.program_counter++)};
-
         switch (opcode) {
             using enum Instruction::Operand;
             case 0x00:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RLC B"}, .duration{2},
-                    .operation{Rlc<reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Rlc<reg8, RegB>>}
+                };
             case 0x01:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RLC C"}, .duration{2},
-                    .operation{Rlc<reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Rlc<reg8, RegC>>}
+                };
             case 0x02:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RLC D"}, .duration{2},
-                    .operation{Rlc<reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Rlc<reg8, RegD>>}
+                };
             case 0x03:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RLC E"}, .duration{2},
-                    .operation{Rlc<reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Rlc<reg8, RegE>>}
+                };
             case 0x04:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RLC H"}, .duration{2},
-                    .operation{Rlc<reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Rlc<reg8, RegH>>}
+                };
             case 0x05:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RLC L"}, .duration{2},
-                    .operation{Rlc<reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Rlc<reg8, RegL>>}
+                };
             case 0x06:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RLC (HL)"}, .duration{4},
-                    .operation{Rlc<reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Rlc<reg16_address, RegHL>>}
+                };
             case 0x07:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RLC A"}, .duration{2},
-                    .operation{Rlc<reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Rlc<reg8, RegA>>}
+                };
             case 0x08:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RRC B"}, .duration{2},
-                    .operation{Rrc<reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Rrc<reg8, RegB>>}
+                };
             case 0x09:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RRC C"}, .duration{2},
-                    .operation{Rrc<reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Rrc<reg8, RegC>>}
+                };
             case 0x0A:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RRC D"}, .duration{2},
-                    .operation{Rrc<reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Rrc<reg8, RegD>>}
+                };
             case 0x0B:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RRC E"}, .duration{2},
-                    .operation{Rrc<reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Rrc<reg8, RegE>>}
+                };
             case 0x0C:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RRC H"}, .duration{2},
-                    .operation{Rrc<reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Rrc<reg8, RegH>>}
+                };
             case 0x0D:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RRC L"}, .duration{2},
-                    .operation{Rrc<reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Rrc<reg8, RegL>>}
+                };
             case 0x0E:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RRC (HL)"}, .duration{4},
-                    .operation{Rrc<reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Rrc<reg16_address, RegHL>>}
+                };
             case 0x0F:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RRC A"}, .duration{2},
-                    .operation{Rrc<reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Rrc<reg8, RegA>>}
+                };
             case 0x10:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RL B"}, .duration{2},
-                    .operation{Rl<reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Rl<reg8, RegB>>}
+                };
             case 0x11:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RL C"}, .duration{2},
-                    .operation{Rl<reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Rl<reg8, RegC>>}
+                };
             case 0x12:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RL D"}, .duration{2},
-                    .operation{Rl<reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Rl<reg8, RegD>>}
+                };
             case 0x13:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RL E"}, .duration{2},
-                    .operation{Rl<reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Rl<reg8, RegE>>}
+                };
             case 0x14:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RL H"}, .duration{2},
-                    .operation{Rl<reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Rl<reg8, RegH>>}
+                };
             case 0x15:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RL L"}, .duration{2},
-                    .operation{Rl<reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Rl<reg8, RegL>>}
+                };
             case 0x16:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RL (HL)"}, .duration{4},
-                    .operation{Rl<reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Rl<reg16_address, RegHL>>}
+                };
             case 0x17:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RL A"}, .duration{2},
-                    .operation{Rl<reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Rl<reg8, RegA>>}
+                };
             case 0x18:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RR B"}, .duration{2},
-                    .operation{Rr<reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Rr<reg8, RegB>>}
+                };
             case 0x19:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RR C"}, .duration{2},
-                    .operation{Rr<reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Rr<reg8, RegC>>}
+                };
             case 0x1A:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RR D"}, .duration{2},
-                    .operation{Rr<reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Rr<reg8, RegD>>}
+                };
             case 0x1B:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RR E"}, .duration{2},
-                    .operation{Rr<reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Rr<reg8, RegE>>}
+                };
             case 0x1C:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RR H"}, .duration{2},
-                    .operation{Rr<reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Rr<reg8, RegH>>}
+                };
             case 0x1D:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RR L"}, .duration{2},
-                    .operation{Rr<reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Rr<reg8, RegL>>}
+                };
             case 0x1E:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RR (HL)"}, .duration{4},
-                    .operation{Rr<reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Rr<reg16_address, RegHL>>}
+                };
             case 0x1F:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RR A"}, .duration{2},
-                    .operation{Rr<reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Rr<reg8, RegA>>}
+                };
             case 0x20:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SLA B"}, .duration{2},
-                    .operation{Sla<reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Sla<reg8, RegB>>}
+                };
             case 0x21:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SLA C"}, .duration{2},
-                    .operation{Sla<reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Sla<reg8, RegC>>}
+                };
             case 0x22:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SLA D"}, .duration{2},
-                    .operation{Sla<reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Sla<reg8, RegD>>}
+                };
             case 0x23:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SLA E"}, .duration{2},
-                    .operation{Sla<reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Sla<reg8, RegE>>}
+                };
             case 0x24:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SLA H"}, .duration{2},
-                    .operation{Sla<reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Sla<reg8, RegH>>}
+                };
             case 0x25:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SLA L"}, .duration{2},
-                    .operation{Sla<reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Sla<reg8, RegL>>}
+                };
             case 0x26:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SLA (HL)"}, .duration{4},
-                    .operation{Sla<reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Sla<reg16_address, RegHL>>}
+                };
             case 0x27:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SLA A"}, .duration{2},
-                    .operation{Sla<reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Sla<reg8, RegA>>}
+                };
             case 0x28:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRA B"}, .duration{2},
-                    .operation{Sra<reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Sra<reg8, RegB>>}
+                };
             case 0x29:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRA C"}, .duration{2},
-                    .operation{Sra<reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Sra<reg8, RegC>>}
+                };
             case 0x2A:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRA D"}, .duration{2},
-                    .operation{Sra<reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Sra<reg8, RegD>>}
+                };
             case 0x2B:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRA E"}, .duration{2},
-                    .operation{Sra<reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Sra<reg8, RegE>>}
+                };
             case 0x2C:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRA H"}, .duration{2},
-                    .operation{Sra<reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Sra<reg8, RegH>>}
+                };
             case 0x2D:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRA L"}, .duration{2},
-                    .operation{Sra<reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Sra<reg8, RegL>>}
+                };
             case 0x2E:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRA (HL)"}, .duration{4},
-                    .operation{Sra<reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Sra<reg16_address, RegHL>>}
+                };
             case 0x2F:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRA A"}, .duration{2},
-                    .operation{Sra<reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Sra<reg8, RegA>>}
+                };
             case 0x30:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SWAP B"}, .duration{2},
-                    .operation{Swap<reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Swap<reg8, RegB>>}
+                };
             case 0x31:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SWAP C"}, .duration{2},
-                    .operation{Swap<reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Swap<reg8, RegC>>}
+                };
             case 0x32:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SWAP D"}, .duration{2},
-                    .operation{Swap<reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Swap<reg8, RegD>>}
+                };
             case 0x33:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SWAP E"}, .duration{2},
-                    .operation{Swap<reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Swap<reg8, RegE>>}
+                };
             case 0x34:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SWAP H"}, .duration{2},
-                    .operation{Swap<reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Swap<reg8, RegH>>}
+                };
             case 0x35:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SWAP L"}, .duration{2},
-                    .operation{Swap<reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Swap<reg8, RegL>>}
+                };
             case 0x36:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SWAP (HL)"}, .duration{4},
-                    .operation{Swap<reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Swap<reg16_address, RegHL>>}
+                };
             case 0x37:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SWAP A"}, .duration{2},
-                    .operation{Swap<reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Swap<reg8, RegA>>}
+                };
             case 0x38:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRL B"}, .duration{2},
-                    .operation{Srl<reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Srl<reg8, RegB>>}
+                };
             case 0x39:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRL C"}, .duration{2},
-                    .operation{Srl<reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Srl<reg8, RegC>>}
+                };
             case 0x3A:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRL D"}, .duration{2},
-                    .operation{Srl<reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Srl<reg8, RegD>>}
+                };
             case 0x3B:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRL E"}, .duration{2},
-                    .operation{Srl<reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Srl<reg8, RegE>>}
+                };
             case 0x3C:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRL H"}, .duration{2},
-                    .operation{Srl<reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Srl<reg8, RegH>>}
+                };
             case 0x3D:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRL L"}, .duration{2},
-                    .operation{Srl<reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Srl<reg8, RegL>>}
+                };
             case 0x3E:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRL (HL)"}, .duration{4},
-                    .operation{Srl<reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Srl<reg16_address, RegHL>>}
+                };
             case 0x3F:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SRL A"}, .duration{2},
-                    .operation{Srl<reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Srl<reg8, RegA>>}
+                };
             case 0x40:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 0, B"}, .duration{2},
-                    .operation{Bit<0, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<0, reg8, RegB>>}
+                };
             case 0x41:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 0, C"}, .duration{2},
-                    .operation{Bit<0, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<0, reg8, RegC>>}
+                };
             case 0x42:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 0, D"}, .duration{2},
-                    .operation{Bit<0, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<0, reg8, RegD>>}
+                };
             case 0x43:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 0, E"}, .duration{2},
-                    .operation{Bit<0, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<0, reg8, RegE>>}
+                };
             case 0x44:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 0, H"}, .duration{2},
-                    .operation{Bit<0, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<0, reg8, RegH>>}
+                };
             case 0x45:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 0, L"}, .duration{2},
-                    .operation{Bit<0, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<0, reg8, RegL>>}
+                };
             case 0x46:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 0, (HL)"}, .duration{3},
-                    .operation{Bit<0, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Bit<0, reg16_address, RegHL>>}
+                };
             case 0x47:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 0, A"}, .duration{2},
-                    .operation{Bit<0, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Bit<0, reg8, RegA>>}
+                };
             case 0x48:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 1, B"}, .duration{2},
-                    .operation{Bit<1, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<1, reg8, RegB>>}
+                };
             case 0x49:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 1, C"}, .duration{2},
-                    .operation{Bit<1, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<1, reg8, RegC>>}
+                };
             case 0x4A:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 1, D"}, .duration{2},
-                    .operation{Bit<1, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<1, reg8, RegD>>}
+                };
             case 0x4B:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 1, E"}, .duration{2},
-                    .operation{Bit<1, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<1, reg8, RegE>>}
+                };
             case 0x4C:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 1, H"}, .duration{2},
-                    .operation{Bit<1, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<1, reg8, RegH>>}
+                };
             case 0x4D:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 1, L"}, .duration{2},
-                    .operation{Bit<1, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<1, reg8, RegL>>}
+                };
             case 0x4E:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 1, (HL)"}, .duration{3},
-                    .operation{Bit<1, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Bit<1, reg16_address, RegHL>>}
+                };
             case 0x4F:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 1, A"}, .duration{2},
-                    .operation{Bit<1, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Bit<1, reg8, RegA>>}
+                };
             case 0x50:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 2, B"}, .duration{2},
-                    .operation{Bit<2, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<2, reg8, RegB>>}
+                };
             case 0x51:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 2, C"}, .duration{2},
-                    .operation{Bit<2, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<2, reg8, RegC>>}
+                };
             case 0x52:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 2, D"}, .duration{2},
-                    .operation{Bit<2, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<2, reg8, RegD>>}
+                };
             case 0x53:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 2, E"}, .duration{2},
-                    .operation{Bit<2, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<2, reg8, RegE>>}
+                };
             case 0x54:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 2, H"}, .duration{2},
-                    .operation{Bit<2, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<2, reg8, RegH>>}
+                };
             case 0x55:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 2, L"}, .duration{2},
-                    .operation{Bit<2, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<2, reg8, RegL>>}
+                };
             case 0x56:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 2, (HL)"}, .duration{3},
-                    .operation{Bit<2, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Bit<2, reg16_address, RegHL>>}
+                };
             case 0x57:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 2, A"}, .duration{2},
-                    .operation{Bit<2, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Bit<2, reg8, RegA>>}
+                };
             case 0x58:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 3, B"}, .duration{2},
-                    .operation{Bit<3, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<3, reg8, RegB>>}
+                };
             case 0x59:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 3, C"}, .duration{2},
-                    .operation{Bit<3, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<3, reg8, RegC>>}
+                };
             case 0x5A:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 3, D"}, .duration{2},
-                    .operation{Bit<3, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<3, reg8, RegD>>}
+                };
             case 0x5B:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 3, E"}, .duration{2},
-                    .operation{Bit<3, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<3, reg8, RegE>>}
+                };
             case 0x5C:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 3, H"}, .duration{2},
-                    .operation{Bit<3, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<3, reg8, RegH>>}
+                };
             case 0x5D:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 3, L"}, .duration{2},
-                    .operation{Bit<3, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<3, reg8, RegL>>}
+                };
             case 0x5E:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 3, (HL)"}, .duration{3},
-                    .operation{Bit<3, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Bit<3, reg16_address, RegHL>>}
+                };
             case 0x5F:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 3, A"}, .duration{2},
-                    .operation{Bit<3, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Bit<3, reg8, RegA>>}
+                };
             case 0x60:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 4, B"}, .duration{2},
-                    .operation{Bit<4, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<4, reg8, RegB>>}
+                };
             case 0x61:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 4, C"}, .duration{2},
-                    .operation{Bit<4, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<4, reg8, RegC>>}
+                };
             case 0x62:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 4, D"}, .duration{2},
-                    .operation{Bit<4, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<4, reg8, RegD>>}
+                };
             case 0x63:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 4, E"}, .duration{2},
-                    .operation{Bit<4, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<4, reg8, RegE>>}
+                };
             case 0x64:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 4, H"}, .duration{2},
-                    .operation{Bit<4, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<4, reg8, RegH>>}
+                };
             case 0x65:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 4, L"}, .duration{2},
-                    .operation{Bit<4, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<4, reg8, RegL>>}
+                };
             case 0x66:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 4, (HL)"}, .duration{3},
-                    .operation{Bit<4, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Bit<4, reg16_address, RegHL>>}
+                };
             case 0x67:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 4, A"}, .duration{2},
-                    .operation{Bit<4, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Bit<4, reg8, RegA>>}
+                };
             case 0x68:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 5, B"}, .duration{2},
-                    .operation{Bit<5, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<5, reg8, RegB>>}
+                };
             case 0x69:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 5, C"}, .duration{2},
-                    .operation{Bit<5, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<5, reg8, RegC>>}
+                };
             case 0x6A:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 5, D"}, .duration{2},
-                    .operation{Bit<5, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<5, reg8, RegD>>}
+                };
             case 0x6B:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 5, E"}, .duration{2},
-                    .operation{Bit<5, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<5, reg8, RegE>>}
+                };
             case 0x6C:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 5, H"}, .duration{2},
-                    .operation{Bit<5, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<5, reg8, RegH>>}
+                };
             case 0x6D:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 5, L"}, .duration{2},
-                    .operation{Bit<5, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<5, reg8, RegL>>}
+                };
             case 0x6E:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 5, (HL)"}, .duration{3},
-                    .operation{Bit<5, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Bit<5, reg16_address, RegHL>>}
+                };
             case 0x6F:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 5, A"}, .duration{2},
-                    .operation{Bit<5, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Bit<5, reg8, RegA>>}
+                };
             case 0x70:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 6, B"}, .duration{2},
-                    .operation{Bit<6, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<6, reg8, RegB>>}
+                };
             case 0x71:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 6, C"}, .duration{2},
-                    .operation{Bit<6, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<6, reg8, RegC>>}
+                };
             case 0x72:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 6, D"}, .duration{2},
-                    .operation{Bit<6, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<6, reg8, RegD>>}
+                };
             case 0x73:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 6, E"}, .duration{2},
-                    .operation{Bit<6, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<6, reg8, RegE>>}
+                };
             case 0x74:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 6, H"}, .duration{2},
-                    .operation{Bit<6, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<6, reg8, RegH>>}
+                };
             case 0x75:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 6, L"}, .duration{2},
-                    .operation{Bit<6, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<6, reg8, RegL>>}
+                };
             case 0x76:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 6, (HL)"}, .duration{3},
-                    .operation{Bit<6, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Bit<6, reg16_address, RegHL>>}
+                };
             case 0x77:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 6, A"}, .duration{2},
-                    .operation{Bit<6, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Bit<6, reg8, RegA>>}
+                };
             case 0x78:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 7, B"}, .duration{2},
-                    .operation{Bit<7, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<7, reg8, RegB>>}
+                };
             case 0x79:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 7, C"}, .duration{2},
-                    .operation{Bit<7, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Bit<7, reg8, RegC>>}
+                };
             case 0x7A:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 7, D"}, .duration{2},
-                    .operation{Bit<7, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<7, reg8, RegD>>}
+                };
             case 0x7B:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 7, E"}, .duration{2},
-                    .operation{Bit<7, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Bit<7, reg8, RegE>>}
+                };
             case 0x7C:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 7, H"}, .duration{2},
-                    .operation{Bit<7, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<7, reg8, RegH>>}
+                };
             case 0x7D:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 7, L"}, .duration{2},
-                    .operation{Bit<7, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Bit<7, reg8, RegL>>}
+                };
             case 0x7E:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 7, (HL)"}, .duration{3},
-                    .operation{Bit<7, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Bit<7, reg16_address, RegHL>>}
+                };
             case 0x7F:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"BIT 7, A"}, .duration{2},
-                    .operation{Bit<7, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Bit<7, reg8, RegA>>}
+                };
             case 0x80:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 0, B"}, .duration{2},
-                    .operation{Res<0, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<0, reg8, RegB>>}
+                };
             case 0x81:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 0, C"}, .duration{2},
-                    .operation{Res<0, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<0, reg8, RegC>>}
+                };
             case 0x82:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 0, D"}, .duration{2},
-                    .operation{Res<0, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Res<0, reg8, RegD>>}
+                };
             case 0x83:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 0, E"}, .duration{2},
-                    .operation{Res<0, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Res<0, reg8, RegE>>}
+                };
             case 0x84:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 0, H"}, .duration{2},
-                    .operation{Res<0, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<0, reg8, RegH>>}
+                };
             case 0x85:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 0, L"}, .duration{2},
-                    .operation{Res<0, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<0, reg8, RegL>>}
+                };
             case 0x86:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 0, (HL)"}, .duration{4},
-                    .operation{Res<0, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Res<0, reg16_address, RegHL>>}
+                };
             case 0x87:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 0, A"}, .duration{2},
-                    .operation{Res<0, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Res<0, reg8, RegA>>}
+                };
             case 0x88:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 1, B"}, .duration{2},
-                    .operation{Res<1, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<1, reg8, RegB>>}
+                };
             case 0x89:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 1, C"}, .duration{2},
-                    .operation{Res<1, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<1, reg8, RegC>>}
+                };
             case 0x8A:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 1, D"}, .duration{2},
-                    .operation{Res<1, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Res<1, reg8, RegD>>}
+                };
             case 0x8B:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 1, E"}, .duration{2},
-                    .operation{Res<1, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Res<1, reg8, RegE>>}
+                };
             case 0x8C:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 1, H"}, .duration{2},
-                    .operation{Res<1, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<1, reg8, RegH>>}
+                };
             case 0x8D:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 1, L"}, .duration{2},
-                    .operation{Res<1, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<1, reg8, RegL>>}
+                };
             case 0x8E:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 1, (HL)"}, .duration{4},
-                    .operation{Res<1, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Res<1, reg16_address, RegHL>>}
+                };
             case 0x8F:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 1, A"}, .duration{2},
-                    .operation{Res<1, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Res<1, reg8, RegA>>}
+                };
             case 0x90:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 2, B"}, .duration{2},
-                    .operation{Res<2, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<2, reg8, RegB>>}
+                };
             case 0x91:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 2, C"}, .duration{2},
-                    .operation{Res<2, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<2, reg8, RegC>>}
+                };
             case 0x92:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 2, D"}, .duration{2},
-                    .operation{Res<2, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Res<2, reg8, RegD>>}
+                };
             case 0x93:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 2, E"}, .duration{2},
-                    .operation{Res<2, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Res<2, reg8, RegE>>}
+                };
             case 0x94:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 2, H"}, .duration{2},
-                    .operation{Res<2, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<2, reg8, RegH>>}
+                };
             case 0x95:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 2, L"}, .duration{2},
-                    .operation{Res<2, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<2, reg8, RegL>>}
+                };
             case 0x96:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 2, (HL)"}, .duration{4},
-                    .operation{Res<2, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Res<2, reg16_address, RegHL>>}
+                };
             case 0x97:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 2, A"}, .duration{2},
-                    .operation{Res<2, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Res<2, reg8, RegA>>}
+                };
             case 0x98:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 3, B"}, .duration{2},
-                    .operation{Res<3, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<3, reg8, RegB>>}
+                };
             case 0x99:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 3, C"}, .duration{2},
-                    .operation{Res<3, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<3, reg8, RegC>>}
+                };
             case 0x9A:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 3, D"}, .duration{2},
-                    .operation{Res<3, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Res<3, reg8, RegD>>}
+                };
             case 0x9B:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 3, E"}, .duration{2},
-                    .operation{Res<3, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Res<3, reg8, RegE>>}
+                };
             case 0x9C:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 3, H"}, .duration{2},
-                    .operation{Res<3, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<3, reg8, RegH>>}
+                };
             case 0x9D:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 3, L"}, .duration{2},
-                    .operation{Res<3, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<3, reg8, RegL>>}
+                };
             case 0x9E:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 3, (HL)"}, .duration{4},
-                    .operation{Res<3, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Res<3, reg16_address, RegHL>>}
+                };
             case 0x9F:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 3, A"}, .duration{2},
-                    .operation{Res<3, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Res<3, reg8, RegA>>}
+                };
             case 0xA0:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 4, B"}, .duration{2},
-                    .operation{Res<4, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<4, reg8, RegB>>}
+                };
             case 0xA1:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 4, C"}, .duration{2},
-                    .operation{Res<4, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<4, reg8, RegC>>}
+                };
             case 0xA2:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 4, D"}, .duration{2},
-                    .operation{Res<4, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Res<4, reg8, RegD>>}
+                };
             case 0xA3:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 4, E"}, .duration{2},
-                    .operation{Res<4, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Res<4, reg8, RegE>>}
+                };
             case 0xA4:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 4, H"}, .duration{2},
-                    .operation{Res<4, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<4, reg8, RegH>>}
+                };
             case 0xA5:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 4, L"}, .duration{2},
-                    .operation{Res<4, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<4, reg8, RegL>>}
+                };
             case 0xA6:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 4, (HL)"}, .duration{4},
-                    .operation{Res<4, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Res<4, reg16_address, RegHL>>}
+                };
             case 0xA7:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 4, A"}, .duration{2},
-                    .operation{Res<4, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Res<4, reg8, RegA>>}
+                };
             case 0xA8:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 5, B"}, .duration{2},
-                    .operation{Res<5, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<5, reg8, RegB>>}
+                };
             case 0xA9:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 5, C"}, .duration{2},
-                    .operation{Res<5, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<5, reg8, RegC>>}
+                };
             case 0xAA:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 5, D"}, .duration{2},
-                    .operation{Res<5, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Res<5, reg8, RegD>>}
+                };
             case 0xAB:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 5, E"}, .duration{2},
-                    .operation{Res<5, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Res<5, reg8, RegE>>}
+                };
             case 0xAC:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 5, H"}, .duration{2},
-                    .operation{Res<5, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<5, reg8, RegH>>}
+                };
             case 0xAD:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 5, L"}, .duration{2},
-                    .operation{Res<5, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<5, reg8, RegL>>}
+                };
             case 0xAE:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 5, (HL)"}, .duration{4},
-                    .operation{Res<5, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Res<5, reg16_address, RegHL>>}
+                };
             case 0xAF:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 5, A"}, .duration{2},
-                    .operation{Res<5, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Res<5, reg8, RegA>>}
+                };
             case 0xB0:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 6, B"}, .duration{2},
-                    .operation{Res<6, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<6, reg8, RegB>>}
+                };
             case 0xB1:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 6, C"}, .duration{2},
-                    .operation{Res<6, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<6, reg8, RegC>>}
+                };
             case 0xB2:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 6, D"}, .duration{2},
-                    .operation{Res<6, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Res<6, reg8, RegD>>}
+                };
             case 0xB3:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 6, E"}, .duration{2},
-                    .operation{Res<6, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Res<6, reg8, RegE>>}
+                };
             case 0xB4:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 6, H"}, .duration{2},
-                    .operation{Res<6, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<6, reg8, RegH>>}
+                };
             case 0xB5:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 6, L"}, .duration{2},
-                    .operation{Res<6, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<6, reg8, RegL>>}
+                };
             case 0xB6:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 6, (HL)"}, .duration{4},
-                    .operation{Res<6, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Res<6, reg16_address, RegHL>>}
+                };
             case 0xB7:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 6, A"}, .duration{2},
-                    .operation{Res<6, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Res<6, reg8, RegA>>}
+                };
             case 0xB8:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 7, B"}, .duration{2},
-                    .operation{Res<7, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<7, reg8, RegB>>}
+                };
             case 0xB9:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 7, C"}, .duration{2},
-                    .operation{Res<7, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Res<7, reg8, RegC>>}
+                };
             case 0xBA:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 7, D"}, .duration{2},
-                    .operation{Res<7, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Res<7, reg8, RegD>>}
+                };
             case 0xBB:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 7, E"}, .duration{2},
-                    .operation{Res<7, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Res<7, reg8, RegE>>}
+                };
             case 0xBC:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 7, H"}, .duration{2},
-                    .operation{Res<7, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<7, reg8, RegH>>}
+                };
             case 0xBD:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 7, L"}, .duration{2},
-                    .operation{Res<7, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Res<7, reg8, RegL>>}
+                };
             case 0xBE:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 7, (HL)"}, .duration{4},
-                    .operation{Res<7, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Res<7, reg16_address, RegHL>>}
+                };
             case 0xBF:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"RES 7, A"}, .duration{2},
-                    .operation{Res<7, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Res<7, reg8, RegA>>}
+                };
             case 0xC0:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 0, B"}, .duration{2},
-                    .operation{Set<0, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<0, reg8, RegB>>}
+                };
             case 0xC1:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 0, C"}, .duration{2},
-                    .operation{Set<0, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<0, reg8, RegC>>}
+                };
             case 0xC2:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 0, D"}, .duration{2},
-                    .operation{Set<0, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Set<0, reg8, RegD>>}
+                };
             case 0xC3:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 0, E"}, .duration{2},
-                    .operation{Set<0, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Set<0, reg8, RegE>>}
+                };
             case 0xC4:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 0, H"}, .duration{2},
-                    .operation{Set<0, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<0, reg8, RegH>>}
+                };
             case 0xC5:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 0, L"}, .duration{2},
-                    .operation{Set<0, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<0, reg8, RegL>>}
+                };
             case 0xC6:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 0, (HL)"}, .duration{4},
-                    .operation{Set<0, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Set<0, reg16_address, RegHL>>}
+                };
             case 0xC7:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 0, A"}, .duration{2},
-                    .operation{Set<0, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Set<0, reg8, RegA>>}
+                };
             case 0xC8:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 1, B"}, .duration{2},
-                    .operation{Set<1, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<1, reg8, RegB>>}
+                };
             case 0xC9:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 1, C"}, .duration{2},
-                    .operation{Set<1, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<1, reg8, RegC>>}
+                };
             case 0xCA:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 1, D"}, .duration{2},
-                    .operation{Set<1, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Set<1, reg8, RegD>>}
+                };
             case 0xCB:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 1, E"}, .duration{2},
-                    .operation{Set<1, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Set<1, reg8, RegE>>}
+                };
             case 0xCC:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 1, H"}, .duration{2},
-                    .operation{Set<1, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<1, reg8, RegH>>}
+                };
             case 0xCD:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 1, L"}, .duration{2},
-                    .operation{Set<1, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<1, reg8, RegL>>}
+                };
             case 0xCE:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 1, (HL)"}, .duration{4},
-                    .operation{Set<1, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Set<1, reg16_address, RegHL>>}
+                };
             case 0xCF:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 1, A"}, .duration{2},
-                    .operation{Set<1, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Set<1, reg8, RegA>>}
+                };
             case 0xD0:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 2, B"}, .duration{2},
-                    .operation{Set<2, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<2, reg8, RegB>>}
+                };
             case 0xD1:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 2, C"}, .duration{2},
-                    .operation{Set<2, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<2, reg8, RegC>>}
+                };
             case 0xD2:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 2, D"}, .duration{2},
-                    .operation{Set<2, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Set<2, reg8, RegD>>}
+                };
             case 0xD3:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 2, E"}, .duration{2},
-                    .operation{Set<2, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Set<2, reg8, RegE>>}
+                };
             case 0xD4:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 2, H"}, .duration{2},
-                    .operation{Set<2, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<2, reg8, RegH>>}
+                };
             case 0xD5:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 2, L"}, .duration{2},
-                    .operation{Set<2, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<2, reg8, RegL>>}
+                };
             case 0xD6:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 2, (HL)"}, .duration{4},
-                    .operation{Set<2, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Set<2, reg16_address, RegHL>>}
+                };
             case 0xD7:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 2, A"}, .duration{2},
-                    .operation{Set<2, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Set<2, reg8, RegA>>}
+                };
             case 0xD8:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 3, B"}, .duration{2},
-                    .operation{Set<3, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<3, reg8, RegB>>}
+                };
             case 0xD9:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 3, C"}, .duration{2},
-                    .operation{Set<3, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<3, reg8, RegC>>}
+                };
             case 0xDA:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 3, D"}, .duration{2},
-                    .operation{Set<3, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Set<3, reg8, RegD>>}
+                };
             case 0xDB:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 3, E"}, .duration{2},
-                    .operation{Set<3, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Set<3, reg8, RegE>>}
+                };
             case 0xDC:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 3, H"}, .duration{2},
-                    .operation{Set<3, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<3, reg8, RegH>>}
+                };
             case 0xDD:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 3, L"}, .duration{2},
-                    .operation{Set<3, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<3, reg8, RegL>>}
+                };
             case 0xDE:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 3, (HL)"}, .duration{4},
-                    .operation{Set<3, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Set<3, reg16_address, RegHL>>}
+                };
             case 0xDF:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 3, A"}, .duration{2},
-                    .operation{Set<3, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Set<3, reg8, RegA>>}
+                };
             case 0xE0:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 4, B"}, .duration{2},
-                    .operation{Set<4, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<4, reg8, RegB>>}
+                };
             case 0xE1:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 4, C"}, .duration{2},
-                    .operation{Set<4, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<4, reg8, RegC>>}
+                };
             case 0xE2:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 4, D"}, .duration{2},
-                    .operation{Set<4, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Set<4, reg8, RegD>>}
+                };
             case 0xE3:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 4, E"}, .duration{2},
-                    .operation{Set<4, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Set<4, reg8, RegE>>}
+                };
             case 0xE4:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 4, H"}, .duration{2},
-                    .operation{Set<4, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<4, reg8, RegH>>}
+                };
             case 0xE5:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 4, L"}, .duration{2},
-                    .operation{Set<4, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<4, reg8, RegL>>}
+                };
             case 0xE6:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 4, (HL)"}, .duration{4},
-                    .operation{Set<4, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Set<4, reg16_address, RegHL>>}
+                };
             case 0xE7:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 4, A"}, .duration{2},
-                    .operation{Set<4, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Set<4, reg8, RegA>>}
+                };
             case 0xE8:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 5, B"}, .duration{2},
-                    .operation{Set<5, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<5, reg8, RegB>>}
+                };
             case 0xE9:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 5, C"}, .duration{2},
-                    .operation{Set<5, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<5, reg8, RegC>>}
+                };
             case 0xEA:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 5, D"}, .duration{2},
-                    .operation{Set<5, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Set<5, reg8, RegD>>}
+                };
             case 0xEB:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 5, E"}, .duration{2},
-                    .operation{Set<5, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Set<5, reg8, RegE>>}
+                };
             case 0xEC:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 5, H"}, .duration{2},
-                    .operation{Set<5, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<5, reg8, RegH>>}
+                };
             case 0xED:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 5, L"}, .duration{2},
-                    .operation{Set<5, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<5, reg8, RegL>>}
+                };
             case 0xEE:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 5, (HL)"}, .duration{4},
-                    .operation{Set<5, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Set<5, reg16_address, RegHL>>}
+                };
             case 0xEF:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 5, A"}, .duration{2},
-                    .operation{Set<5, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Set<5, reg8, RegA>>}
+                };
             case 0xF0:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 6, B"}, .duration{2},
-                    .operation{Set<6, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<6, reg8, RegB>>}
+                };
             case 0xF1:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 6, C"}, .duration{2},
-                    .operation{Set<6, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<6, reg8, RegC>>}
+                };
             case 0xF2:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 6, D"}, .duration{2},
-                    .operation{Set<6, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Set<6, reg8, RegD>>}
+                };
             case 0xF3:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 6, E"}, .duration{2},
-                    .operation{Set<6, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Set<6, reg8, RegE>>}
+                };
             case 0xF4:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 6, H"}, .duration{2},
-                    .operation{Set<6, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<6, reg8, RegH>>}
+                };
             case 0xF5:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 6, L"}, .duration{2},
-                    .operation{Set<6, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<6, reg8, RegL>>}
+                };
             case 0xF6:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 6, (HL)"}, .duration{4},
-                    .operation{Set<6, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Set<6, reg16_address, RegHL>>}
+                };
             case 0xF7:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 6, A"}, .duration{2},
-                    .operation{Set<6, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Set<6, reg8, RegA>>}
+                };
             case 0xF8:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 7, B"}, .duration{2},
-                    .operation{Set<7, reg8>{Reg16High{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<7, reg8, RegB>>}
+                };
             case 0xF9:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 7, C"}, .duration{2},
-                    .operation{Set<7, reg8>{Reg16Low{regs.bc}}}
-                }; break;
+                    .operation{operate<Set<7, reg8, RegC>>}
+                };
             case 0xFA:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 7, D"}, .duration{2},
-                    .operation{Set<7, reg8>{Reg16High{regs.de}}}
-                }; break;
+                    .operation{operate<Set<7, reg8, RegD>>}
+                };
             case 0xFB:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 7, E"}, .duration{2},
-                    .operation{Set<7, reg8>{Reg16Low{regs.de}}}
-                }; break;
+                    .operation{operate<Set<7, reg8, RegE>>}
+                };
             case 0xFC:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 7, H"}, .duration{2},
-                    .operation{Set<7, reg8>{Reg16High{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<7, reg8, RegH>>}
+                };
             case 0xFD:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 7, L"}, .duration{2},
-                    .operation{Set<7, reg8>{Reg16Low{regs.hl}}}
-                }; break;
+                    .operation{operate<Set<7, reg8, RegL>>}
+                };
             case 0xFE:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 7, (HL)"}, .duration{4},
-                    .operation{Set<7, reg16_address>{regs.hl}}
-                }; break;
+                    .operation{operate<Set<7, reg16_address, RegHL>>}
+                };
             case 0xFF:
-                instruction = {
+                return {
                     .opcode{0xCB00 + opcode}, .name{"SET 7, A"}, .duration{2},
-                    .operation{Set<7, reg8>{Reg16High{regs.af}}}
-                }; break;
+                    .operation{operate<Set<7, reg8, RegA>>}
+                };
             default:
                 break;
         }
@@ -2629,15 +2568,217 @@ namespace gameboy::cpu {
         return {};
     }
 
+    /*
+        All 512 instructions are decoded once at compile time: [0x000, 0x0FF] for the base opcodes
+        and [0x100, 0x1FF] for the ones prefixed by 0xCB. Fetching an instruction is then a copy of
+        a small descriptor instead of building a new one on every opcode.
+    */
+    constexpr auto instruction_table{[]() {
+        std::array<Instruction, 512> table{};
+        for (auto i{0}; i < 256; ++i) {
+            table[i] = decode(i);
+            table[256 + i] = decode_prefixed(i);
+        }
+        return table;
+    }()};
+
+    constexpr Instruction halted_instruction{
+        .opcode{}, .name{"HALTED"}, .duration{1},
+        .operation{operate<Halting>}
+    };
+
+    constexpr Instruction interrupt_instruction{
+        .opcode{}, .name{"ISR"}, .duration{5},
+        .operation{operate<HandleInterrupt>}
+    };
+
+    /*
+        The instruction in flight is saved by its index: 0-255 and 256-511 for the table,
+        followed by the two instructions that don't come from an opcode.
+    */
+    constexpr int halted_index{512};
+    constexpr int interrupt_index{513};
+
+    int index_of(const Instruction& instruction)
+    {
+        if (instruction.operation.step == halted_instruction.operation.step) {
+            return halted_index;
+        }
+
+        if (instruction.operation.step == interrupt_instruction.operation.step) {
+            return interrupt_index;
+        }
+
+        return instruction.opcode >= 0xCB00 ? 256 + (instruction.opcode - 0xCB00) : instruction.opcode;
+    }
+
+    Instruction from_index(int index)
+    {
+        switch (index) {
+            case halted_index:
+                return halted_instruction;
+            case interrupt_index:
+                return interrupt_instruction;
+            default:
+                if (index < 0 || index >= std::ssize(instruction_table)) {
+                    throw std::out_of_range{"Invalid instruction."};
+                }
+
+                return instruction_table[index];
+        }
+    }
+
+    Core::Core(std::unique_ptr<io::Bus> bus, std::reference_wrapper<system::Interrupt> interrupt_ref)
+        : interrupt{std::move(interrupt_ref)}
+        , p_bus{std::move(bus)}
+    {
+    }
+
+    void Core::tick()
+    {
+        execute(instruction.operation.step);
+
+        if (m_cycle == instruction.duration) {
+            fetch();
+        }
+    }
+
+    int Core::step()
+    {
+        auto elapsed{0};
+        while (m_cycle < instruction.duration) {
+            Instruction::SideEffect result{};
+            elapsed += instruction.operation.run(m_cycle, instruction.duration, result, regs, *p_bus);
+            resolve(result);
+
+            if (result.cycle_adjustment < 0) {
+                // Halted: return the elapsed cycles so that the other components can request an interrupt.
+                return elapsed;
+            }
+        }
+
+        fetch();
+        return elapsed;
+    }
+
+    bool Core::is_halted() const
+    {
+        return instruction.operation.step == halted_instruction.operation.step;
+    }
+
+    void Core::set_loop_detection(bool enabled)
+    {
+        is_detecting_loops = enabled;
+        loop_detector.reset();
+        idle_loop.reset();
+    }
+
+    void Core::preboot()
+    {
+        regs.af.set_high(0x01);
+        regs.af.set_low(FlagRegister{0xB0});
+        regs.bc = 0x0013;
+        regs.de = 0x00D8;
+        regs.hl = 0x014D;
+        regs.sp = 0xFFFE;
+        regs.program_counter = 0x0100;
+    }
+
+    void Core::save(state::Writer& out) const
+    {
+        out.write(regs.af.get_high());
+        out.write(regs.af.get_low<FlagRegister>().data());
+        for (const auto* p_pair : {&regs.bc, &regs.de, &regs.hl, &regs.sp, &regs.program_counter, &regs.address_latch}) {
+            out.write(static_cast<std::uint16_t>(*p_pair));
+        }
+
+        out.write(regs.data_latch);
+        out.write(m_cycle);
+        out.write(static_cast<std::int16_t>(index_of(instruction)));
+        out.write(interrupt_master_enable);
+        p_bus->save(out);
+    }
+
+    void Core::load(state::Reader& in)
+    {
+        regs.af.set_high(in.read<std::uint8_t>());
+        regs.af.set_low(FlagRegister{in.read<std::uint8_t>()});
+        for (auto* p_pair : {&regs.bc, &regs.de, &regs.hl, &regs.sp, &regs.program_counter, &regs.address_latch}) {
+            *p_pair = in.read<std::uint16_t>();
+        }
+
+        regs.data_latch = in.read<std::uint8_t>();
+        m_cycle = in.read<int>();
+        instruction = from_index(in.read<std::int16_t>());
+        interrupt_master_enable = in.read<bool>();
+        p_bus->load(in);
+
+        // The loop in progress is observed again from scratch.
+        instruction_address = 0;
+        loop_detector.reset();
+        idle_loop.reset();
+    }
+
+    void Core::fetch()
+    {
+        auto address{static_cast<std::uint16_t>(regs.program_counter)};
+        if (address < instruction_address && is_detecting_loops) {
+            track_loop(address);
+        }
+
+        instruction_address = address;
+        auto opcode{p_bus->read_byte(regs.program_counter++)};
+        instruction = instruction_table[opcode];
+        m_cycle = 0;
+
+        check_interrupt();
+    }
+
+    void Core::execute(Instruction::Step func)
+    {
+        Instruction::SideEffect result{func(m_cycle++, regs, *p_bus)};
+        m_cycle += result.cycle_adjustment;
+        resolve(result);
+    }
+
+    void Core::resolve(const Instruction::SideEffect& result)
+    {
+        if (result.ime_adjustment.has_value()) {
+            interrupt_master_enable = *result.ime_adjustment;
+        }
+
+        if (result.halt_attempt.has_value()) {
+            if (result.halt_attempt->success) {
+                instruction = halted_instruction;
+            }
+            else {
+                instruction = instruction_table[p_bus->read_byte(regs.program_counter)];
+            }
+        }
+
+        if (result.prefixed_opcode.has_value()) {
+            instruction = instruction_table[256 + *result.prefixed_opcode];
+        }
+    }
+
     void Core::check_interrupt()
     {
-        if (interrupt_master_enable && has_pending_interrupt(*p_bus)) {
+        if (interrupt_master_enable && interrupt.get().has_pending()) {
             --regs.program_counter;
             interrupt_master_enable = false;
-            instruction = {
-                .opcode{}, .name{"ISR"}, .duration{5},
-                .operation{handle_interrupt}
-            };
+            instruction = interrupt_instruction;
+
+            // The handler may change anything the loop reads, or even the loop itself.
+            loop_detector.reset();
+            idle_loop.reset();
+        }
+    }
+
+    // The previous instruction has just jumped backwards, or returned from somewhere else.
+    void Core::track_loop(std::uint16_t head)
+    {
+        if (loop_detector.observe(head, instruction_address, instruction.opcode, regs, *p_bus)) {
+            idle_loop = head;
         }
     }
 }
\ No newline at end of file
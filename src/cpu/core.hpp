@@ -1,30 +1,53 @@
 #ifndef CPU_CORE_H
 #define CPU_CORE_H
 
+#include <functional>
 #include <memory>
+#include <optional>
+#include <utility>
 #include "io/bus.hpp"
 #include "instruction.hpp"
+#include "loop.hpp"
 #include "registers.hpp"
-#include "debugger.hpp"
+#include "state.hpp"
+#include "system/interrupt.hpp"
 
 namespace gameboy::cpu {
     class Core {
     public:
-        explicit Core(std::unique_ptr<io::Bus> p_bus);
+        Core(std::unique_ptr<io::Bus> p_bus, std::reference_wrapper<system::Interrupt> interrupt_ref);
         void tick();
+        int step();
         void preboot();
+        bool is_halted() const; // nothing but an interrupt request changes the state until it's left
+        void set_loop_detection(bool enabled);
+
+        // The head of the idle loop the CPU has just come back to with the same registers, see LoopDetector.
+        std::optional<std::uint16_t> take_idle_loop()
+        {
+            return std::exchange(idle_loop, std::nullopt);
+        }
+
         void test();
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
 
     private:
-        Instruction decode(int opcode);
-        void execute(const Instruction::Operation& func);
-        Instruction::SideEffect resolve_prefixed_instruction();
+        void fetch();
+        void execute(Instruction::Step func);
+        void resolve(const Instruction::SideEffect& result);
         void check_interrupt();
+        void track_loop(std::uint16_t head);
 
         int m_cycle{0};
+        std::uint16_t instruction_address{}; // where the instruction in flight was fetched
         Instruction instruction{};
         Registers regs{};
         bool interrupt_master_enable{};
+        bool is_detecting_loops{true};
+        LoopDetector loop_detector{};
+        std::optional<std::uint16_t> idle_loop{};
+        std::reference_wrapper<system::Interrupt> interrupt;
         std::unique_ptr<io::Bus> p_bus;
     };
 }
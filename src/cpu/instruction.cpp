@@ -3,13 +3,13 @@
 namespace gameboy::cpu {
     void relative_jump(int cycle, Registers& regs, gameboy::io::Bus& mmu)
     {
-        static std::int8_t offset{};
+        auto& offset{regs.data_latch};
         switch (cycle) {
             case 0:
                 offset = mmu.read_byte(regs.program_counter++);
                 return;
             case 1:
-                regs.program_counter = static_cast<std::uint16_t>(regs.program_counter + offset);
+                regs.program_counter = static_cast<std::uint16_t>(regs.program_counter + static_cast<std::int8_t>(offset));
                 return;
             default:
                 return;
@@ -18,7 +18,7 @@ namespace gameboy::cpu {
 
     void jump(int cycle, Registers& regs, gameboy::io::Bus& mmu)
     {
-        static PairedRegister address{{}, std::uint8_t{}};
+        auto& address{regs.address_latch};
         switch (cycle) {
             case 0:
                 address.set_low(mmu.read_byte(regs.program_counter++));
@@ -53,7 +53,7 @@ namespace gameboy::cpu {
 
     void call(int cycle, Registers& regs, gameboy::io::Bus& mmu)
     {
-        static PairedRegister address{{}, std::uint8_t{}};
+        auto& address{regs.address_latch};
         switch (cycle) {
             case 0:
                 address.set_low(mmu.read_byte(regs.program_counter++));
@@ -1,9 +1,8 @@
 #ifndef CPU_INSTRUCTION_H
 #define CPU_INSTRUCTION_H
 
-#include <functional>
 #include <optional>
-#include <string>
+#include <string_view>
 #include "io/bus.hpp"
 #include "arithmetic.hpp"
 #include "registers.hpp"
@@ -18,9 +17,16 @@ namespace gameboy::cpu {
             int cycle_adjustment{};
             std::optional<bool> ime_adjustment{};
             std::optional<TryHalt> halt_attempt{};
+            std::optional<int> prefixed_opcode{};
         };
 
-        using Operation = std::function<Instruction::SideEffect(int, Registers&, gameboy::io::Bus&)>;
+        using Step = Instruction::SideEffect (*)(int, Registers&, gameboy::io::Bus&);
+        using Run = int (*)(int&, int, Instruction::SideEffect&, Registers&, gameboy::io::Bus&);
+
+        struct Operation {
+            Step step; // perform a single m-cycle
+            Run run;   // perform the remaining m-cycles at once
+        };
 
         enum class Operand {
             reg16,
@@ -36,35 +42,97 @@ namespace gameboy::cpu {
         };
 
         int opcode{};
-        std::string name{};
+        std::string_view name{};
         int duration{1}; // m-cycle
-        Operation operation{[](int, Registers&, gameboy::io::Bus&) -> SideEffect { return {}; }};
+        Operation operation{
+            [](int, Registers&, gameboy::io::Bus&) -> SideEffect { return {}; },
+            [](int& cycle, int duration, SideEffect&, Registers&, gameboy::io::Bus&) -> int {
+                auto elapsed{duration - cycle};
+                cycle = duration;
+                return elapsed;
+            }
+        };
     };
 
     inline bool has_pending_interrupt(const gameboy::io::Bus& mmu)
     {
-        return mmu.read_byte(0xFF0F) & mmu.read_byte(0xFFFF) & 0x1F;
+        return mmu.get_interrupt().has_pending();
     }
 
-    using Reg16Ref = std::reference_wrapper<PairedRegister>;
-    using Reg8Getter = std::uint8_t (Reg16Ref::type::*)() const;
-    using Reg8Setter = void (Reg16Ref::type::*)(std::uint8_t);
+    /*
+        The operands are bound at compile time rather than by reference, so that every operation
+        is a stateless type and can be stored as a plain function pointer in the opcode table.
+    */
+    template<PairedRegister Registers::*Member>
+    struct Reg16 {
+        static PairedRegister& get(Registers& regs) { return regs.*Member; }
+    };
 
+    template<PairedRegister Registers::*Member>
     struct Reg16High {
-        Reg16Ref rr;
-        Reg8Getter getter{&Reg16Ref::type::get_high};
-        Reg8Setter setter{&Reg16Ref::type::set_high};
+        static std::uint8_t read(const Registers& regs) { return (regs.*Member).get_high(); }
+        static void write(Registers& regs, std::uint8_t value) { (regs.*Member).set_high(value); }
     };
 
+    template<PairedRegister Registers::*Member>
     struct Reg16Low {
-        Reg16Ref rr;
-        Reg8Getter getter{&Reg16Ref::type::get_low};
-        Reg8Setter setter{&Reg16Ref::type::set_low};
-    };
+        static std::uint8_t read(const Registers& regs) { return (regs.*Member).template get_low<std::uint8_t>(); }
+        static void write(Registers& regs, std::uint8_t value) { (regs.*Member).set_low(value); }
+    };
+
+    using RegAF = Reg16<&Registers::af>;
+    using RegBC = Reg16<&Registers::bc>;
+    using RegDE = Reg16<&Registers::de>;
+    using RegHL = Reg16<&Registers::hl>;
+    using RegSP = Reg16<&Registers::sp>;
+    using RegA = Reg16High<&Registers::af>;
+    using RegB = Reg16High<&Registers::bc>;
+    using RegC = Reg16Low<&Registers::bc>;
+    using RegD = Reg16High<&Registers::de>;
+    using RegE = Reg16Low<&Registers::de>;
+    using RegH = Reg16High<&Registers::hl>;
+    using RegL = Reg16Low<&Registers::hl>;
+
+    template<typename Op>
+    Instruction::SideEffect step_operation(int cycle, Registers& regs, gameboy::io::Bus& mmu)
+    {
+        return Op{}(cycle, regs, mmu);
+    }
+
+    /*
+        Run the operation from the given m-cycle to the end of the instruction within one call, so the
+        per-cycle switch is inlined rather than dispatched through a pointer every m-cycle. It stops early
+        whenever the core has to take over: a HALT attempt, a CB prefix or a stall (cycle adjustment < 0).
+    */
+    template<typename Op>
+    int run_operation(int& cycle, int duration, Instruction::SideEffect& effect, Registers& regs, gameboy::io::Bus& mmu)
+    {
+        auto elapsed{0};
+        while (cycle < duration) {
+            auto ime_adjustment{effect.ime_adjustment};
+            effect = Op{}(cycle++, regs, mmu);
+            cycle += effect.cycle_adjustment;
+            ++elapsed;
+
+            if (!effect.ime_adjustment.has_value()) {
+                effect.ime_adjustment = ime_adjustment;
+            }
+
+            if (effect.cycle_adjustment < 0 || effect.halt_attempt.has_value() || effect.prefixed_opcode.has_value()) {
+                break;
+            }
+        }
+
+        return elapsed;
+    }
+
+    // Both entry points of a stateless operation, as stored in an instruction.
+    template<typename Op>
+    constexpr Instruction::Operation operate{&step_operation<Op>, &run_operation<Op>};
 
     template<Flag Option, bool Status>
     struct FlagPredicate {
-        bool operator()(Registers& regs)
+        bool operator()(const Registers& regs) const
         {
             return regs[Option] == Status;
         }
@@ -114,117 +182,96 @@ namespace gameboy::cpu {
         }
     };
 
+    // PREFIX CB: the next byte selects an instruction from the extended table
+    struct Prefix {
+        Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus& mmu)
+        {
+            return {.prefixed_opcode{mmu.read_byte(regs.program_counter++)}};
+        }
+    };
+
     // LD: load
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct Ld;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct Ld;
 
     // LD r, u8
-    template<>
-    struct Ld<Instruction::Operand::reg8, Instruction::Operand::u8> {
-        Ld(Reg16High reg1) : rr{reg1.rr}, write{reg1.setter} {}
-        Ld(Reg16Low reg1) : rr{reg1.rr}, write{reg1.setter} {}
+    template<typename R1>
+    struct Ld<Instruction::Operand::reg8, Instruction::Operand::u8, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    (rr.get().*write)(mmu.read_byte(regs.program_counter++));
+                    R1::write(regs, mmu.read_byte(regs.program_counter++));
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
-        Reg8Setter write;
     };
 
     // LD r, r′
-    template<>
-    struct Ld<Instruction::Operand::reg8, Instruction::Operand::reg8> {
-        Ld(Reg16High reg1, Reg16High reg2) : rr1{reg1.rr}, rr2{reg2.rr}, read{reg2.getter}, write{reg1.setter} {}
-        Ld(Reg16High reg1, Reg16Low reg2) : rr1{reg1.rr}, rr2{reg2.rr}, read{reg2.getter}, write{reg1.setter} {}
-        Ld(Reg16Low reg1, Reg16High reg2) : rr1{reg1.rr}, rr2{reg2.rr}, read{reg2.getter}, write{reg1.setter} {}
-        Ld(Reg16Low reg1, Reg16Low reg2) : rr1{reg1.rr}, rr2{reg2.rr}, read{reg2.getter}, write{reg1.setter} {}
+    template<typename R1, typename R2>
+    struct Ld<Instruction::Operand::reg8, Instruction::Operand::reg8, R1, R2> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            (rr1.get().*write)((rr2.get().*read)());
+            R1::write(regs, R2::read(regs));
             return {};
         }
-    private:
-        Reg16Ref rr1;
-        Reg16Ref rr2;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // LD r, (rr)
-    template<>
-    struct Ld<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        Ld(Reg16High reg1, Reg16Ref reg2) : rr1{reg1.rr}, rr2{reg2}, write{reg1.setter} {}
-        Ld(Reg16Low reg1, Reg16Ref reg2) : rr1{reg1.rr}, rr2{reg2}, write{reg1.setter} {}
-        Instruction::SideEffect operator()(int cycle, Registers&, gameboy::io::Bus& mmu)
+    template<typename R1, typename R2>
+    struct Ld<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1, R2> {
+        Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    (rr1.get().*write)(mmu.read_byte(rr2.get()));
+                    R1::write(regs, mmu.read_byte(R2::get(regs)));
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr1;
-        Reg16Ref rr2;
-        Reg8Setter write;
     };
 
     // LD (rr), u8
-    template<>
-    struct Ld<Instruction::Operand::reg16_address, Instruction::Operand::u8> {
-        Ld(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Ld<Instruction::Operand::reg16_address, Instruction::Operand::u8, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 0:
                     temp = mmu.read_byte(regs.program_counter++);
                     return {};
                 case 1:
-                    mmu.write_byte(rr.get(), temp);
+                    mmu.write_byte(R1::get(regs), temp);
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // LD (rr), r
-    template<>
-    struct Ld<Instruction::Operand::reg16_address, Instruction::Operand::reg8> {
-        Ld(Reg16Ref reg1, Reg16High reg2) : rr1{reg1}, rr2{reg2.rr}, read{reg2.getter} {}
-        Ld(Reg16Ref reg1, Reg16Low reg2) : rr1{reg1}, rr2{reg2.rr}, read{reg2.getter} {}
-        Instruction::SideEffect operator()(int cycle, Registers&, gameboy::io::Bus& mmu)
+    template<typename R1, typename R2>
+    struct Ld<Instruction::Operand::reg16_address, Instruction::Operand::reg8, R1, R2> {
+        Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    mmu.write_byte(rr1.get(), (rr2.get().*read)());
+                    mmu.write_byte(R1::get(regs), R2::read(regs));
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr1;
-        Reg16Ref rr2;
-        Reg8Getter read;
     };
 
     // LD A, (u16)
     template<>
-    struct Ld<Instruction::Operand::reg8, Instruction::Operand::u16_address>{
+    struct Ld<Instruction::Operand::reg8, Instruction::Operand::u16_address> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static PairedRegister address{{}, std::uint8_t{}};
+            auto& address{regs.address_latch};
             switch (cycle) {
                 case 0:
                     address.set_low(mmu.read_byte(regs.program_counter++));
@@ -242,23 +289,18 @@ namespace gameboy::cpu {
     };
 
     // LD A, (FF00 + r)
-    template<>
-    struct Ld<Instruction::Operand::reg8, Instruction::Operand::reg8_address> {
-        Ld(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        Ld(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<typename R1>
+    struct Ld<Instruction::Operand::reg8, Instruction::Operand::reg8_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    regs.af.set_high(mmu.read_byte(0xFF00 + (rr.get().*read)()));
+                    regs.af.set_high(mmu.read_byte(0xFF00 + R1::read(regs)));
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
     // LD A, (FF00 + u8)
@@ -266,7 +308,7 @@ namespace gameboy::cpu {
     struct Ld<Instruction::Operand::reg8, Instruction::Operand::u8_address> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t offset{};
+            auto& offset{regs.data_latch};
             switch (cycle) {
                 case 0:
                     offset = mmu.read_byte(regs.program_counter++);
@@ -281,23 +323,18 @@ namespace gameboy::cpu {
     };
 
     // LD (FF00 + r), A
-    template<>
-    struct Ld<Instruction::Operand::reg8_address, Instruction::Operand::reg8> {
-        Ld(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        Ld(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<typename R1>
+    struct Ld<Instruction::Operand::reg8_address, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    mmu.write_byte(0xFF00 + (rr.get().*read)(), regs.af.get_high());
+                    mmu.write_byte(0xFF00 + R1::read(regs), regs.af.get_high());
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
     // LD (FF00 + u8), A
@@ -305,7 +342,7 @@ namespace gameboy::cpu {
     struct Ld<Instruction::Operand::u8_address, Instruction::Operand::reg8> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t offset{};
+            auto& offset{regs.data_latch};
             switch (cycle) {
                 case 0:
                     offset = mmu.read_byte(regs.program_counter++);
@@ -320,59 +357,51 @@ namespace gameboy::cpu {
     };
 
     // LD rr, u16
-    template<>
-    struct Ld<Instruction::Operand::reg16, Instruction::Operand::u16> {
-        Ld(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Ld<Instruction::Operand::reg16, Instruction::Operand::u16, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    rr.get().set_low(mmu.read_byte(regs.program_counter++));
+                    R1::get(regs).set_low(mmu.read_byte(regs.program_counter++));
                     return {};
                 case 1:
-                    rr.get().set_high(mmu.read_byte(regs.program_counter++));
+                    R1::get(regs).set_high(mmu.read_byte(regs.program_counter++));
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // LD rr, rr′
-    template<>
-    struct Ld<Instruction::Operand::reg16, Instruction::Operand::reg16> {
-        Ld(Reg16Ref reg1, Reg16Ref reg2) : rr1{reg1}, rr2{reg2} {}
-        Instruction::SideEffect operator()(int cycle, Registers&, gameboy::io::Bus&)
+    template<typename R1, typename R2>
+    struct Ld<Instruction::Operand::reg16, Instruction::Operand::reg16, R1, R2> {
+        Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus&)
         {
             switch (cycle) {
                 case 0:
-                    rr1.get() = rr2.get();
+                    R1::get(regs) = R2::get(regs);
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr1;
-        Reg16Ref rr2;
     };
 
     // LD rr, rr′ + i8
-    template<>
-    struct Ld<Instruction::Operand::reg16, Instruction::Operand::reg16_offset> {
-        Ld(Reg16Ref reg1, Reg16Ref reg2) : rr1{reg1}, rr2{reg2} {}
+    template<typename R1, typename R2>
+    struct Ld<Instruction::Operand::reg16, Instruction::Operand::reg16_offset, R1, R2> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::int8_t offset{};
+            auto& offset{regs.data_latch};
             switch (cycle) {
                 case 0:
                     offset = mmu.read_byte(regs.program_counter++);
                     return {};
                 case 1: {
-                        AluResult result{add(rr2.get(), offset)};
-                        rr1.get() = result.output;
+                        AluResult result{add(R2::get(regs), static_cast<std::int8_t>(offset))};
+                        R1::get(regs) = result.output;
                         adjust_flag(regs, {false, false, result.half_carry, result.carry});
                     }
                     return {};
@@ -380,17 +409,14 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr1;
-        Reg16Ref rr2;
     };
 
     // LD (u16), A
     template<>
-    struct Ld<Instruction::Operand::u16_address, Instruction::Operand::reg8>{
+    struct Ld<Instruction::Operand::u16_address, Instruction::Operand::reg8> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static PairedRegister address{{}, std::uint8_t{}};
+            auto& address{regs.address_latch};
             switch (cycle) {
                 case 0:
                     address.set_low(mmu.read_byte(regs.program_counter++));
@@ -408,12 +434,11 @@ namespace gameboy::cpu {
     };
 
     // LD (u16), rr
-    template<>
-    struct Ld<Instruction::Operand::u16_address, Instruction::Operand::reg16> {
-        Ld(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Ld<Instruction::Operand::u16_address, Instruction::Operand::reg16, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static PairedRegister address{{}, std::uint8_t{}};
+            auto& address{regs.address_latch};
             switch (cycle) {
                 case 0:
                     address.set_low(mmu.read_byte(regs.program_counter++));
@@ -422,254 +447,210 @@ namespace gameboy::cpu {
                     address.set_high(mmu.read_byte(regs.program_counter++));
                     return {};
                 case 2:
-                    mmu.write_byte(address++, rr.get().get_low<std::uint8_t>());
+                    mmu.write_byte(address++, R1::get(regs).template get_low<std::uint8_t>());
                     return {};
                 case 3:
-                    mmu.write_byte(address, rr.get().get_high());
+                    mmu.write_byte(address, R1::get(regs).get_high());
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // LDI
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct Ldi;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct Ldi;
 
     // LD (rr+), A
-    template<>
-    struct Ldi<Instruction::Operand::reg16_address, Instruction::Operand::reg8> {
-        Ldi(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Ldi<Instruction::Operand::reg16_address, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    mmu.write_byte(rr.get()++, regs.af.get_high());
+                    mmu.write_byte(R1::get(regs)++, regs.af.get_high());
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // LD A, (rr+)
-    template<>
-    struct Ldi<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        Ldi(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Ldi<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    regs.af.set_high(mmu.read_byte(rr.get()++));
+                    regs.af.set_high(mmu.read_byte(R1::get(regs)++));
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // LDD
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct Ldd;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct Ldd;
 
     // LD (rr-), A
-    template<>
-    struct Ldd<Instruction::Operand::reg16_address, Instruction::Operand::reg8> {
-        Ldd(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Ldd<Instruction::Operand::reg16_address, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    mmu.write_byte(rr.get()--, regs.af.get_high());
+                    mmu.write_byte(R1::get(regs)--, regs.af.get_high());
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // LD A, (rr-)
-    template<>
-    struct Ldd<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        Ldd(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Ldd<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    regs.af.set_high(mmu.read_byte(rr.get()--));
+                    regs.af.set_high(mmu.read_byte(R1::get(regs)--));
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // INC
-    template<Instruction::Operand Op1> struct Inc;
+    template<Instruction::Operand Op1, typename R1 = void> struct Inc;
 
     // INC rr
-    template<>
-    struct Inc<Instruction::Operand::reg16> {
-        Inc(Reg16Ref reg1) : rr{reg1} {}
-        Instruction::SideEffect operator()(int cycle, Registers&, gameboy::io::Bus&)
+    template<typename R1>
+    struct Inc<Instruction::Operand::reg16, R1> {
+        Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus&)
         {
             switch (cycle) {
                 case 0:
-                    ++rr.get();
+                    ++R1::get(regs);
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // INC r
-    template<>
-    struct Inc<Instruction::Operand::reg8> {
-        Inc(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Inc(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
+    template<typename R1>
+    struct Inc<Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult result{add((rr.get().*read)(), std::uint8_t{1})};
-            (rr.get().*write)(result.output);
+            AluResult result{add(R1::read(regs), std::uint8_t{1})};
+            R1::write(regs, result.output);
             adjust_flag(regs, {result.output == 0, false, result.half_carry, {}});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // INC (rr)
-    template<>
-    struct Inc<Instruction::Operand::reg16_address> {
-        Inc(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Inc<Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 0:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     return {};
                 case 1: {
                         AluResult result{add(temp, std::uint8_t{1})};
                         adjust_flag(regs, {result.output == 0, false, result.half_carry, {}});
-                        mmu.write_byte(rr.get(), result.output);
+                        mmu.write_byte(R1::get(regs), result.output);
                     }
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // DEC
-    template<Instruction::Operand Op1> struct Dec;
+    template<Instruction::Operand Op1, typename R1 = void> struct Dec;
 
     // DEC rr
-    template<>
-    struct Dec<Instruction::Operand::reg16> {
-        Dec(Reg16Ref reg1) : rr{reg1} {}
-        Instruction::SideEffect operator()(int cycle, Registers&, gameboy::io::Bus&)
+    template<typename R1>
+    struct Dec<Instruction::Operand::reg16, R1> {
+        Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus&)
         {
             switch (cycle) {
                 case 0:
-                    --rr.get();
+                    --R1::get(regs);
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // DEC r
-    template<>
-    struct Dec<Instruction::Operand::reg8> {
-        Dec(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Dec(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
+    template<typename R1>
+    struct Dec<Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult result{sub((rr.get().*read)(), std::uint8_t{1})};
-            (rr.get().*write)(result.output);
+            AluResult result{sub(R1::read(regs), std::uint8_t{1})};
+            R1::write(regs, result.output);
             adjust_flag(regs, {result.output == 0, true, result.half_carry, {}});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // DEC (rr)
-    template<>
-    struct Dec<Instruction::Operand::reg16_address> {
-        Dec(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Dec<Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 0:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     return {};
                 case 1: {
                         AluResult result{sub(temp, std::uint8_t{1})};
                         adjust_flag(regs, {result.output == 0, true, result.half_carry, {}});
-                        mmu.write_byte(rr.get(), result.output);
+                        mmu.write_byte(R1::get(regs), result.output);
                     }
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // ADD
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct Add;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct Add;
 
     // ADD A, r
-    template<>
-    struct Add<Instruction::Operand::reg8, Instruction::Operand::reg8> {
-        Add(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        Add(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<typename R1>
+    struct Add<Instruction::Operand::reg8, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult result{add(regs.af.get_high(), (rr.get().*read)())};
+            AluResult result{add(regs.af.get_high(), R1::read(regs))};
             regs.af.set_high(result.output);
             adjust_flag(regs, {result.output == 0, false, result.half_carry, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
     // ADD A, (rr)
-    template<>
-    struct Add<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        Add(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Add<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0: {
-                        AluResult result{add(regs.af.get_high(), mmu.read_byte(rr.get()))};
+                        AluResult result{add(regs.af.get_high(), mmu.read_byte(R1::get(regs)))};
                         regs.af.set_high(result.output);
                         adjust_flag(regs, {result.output == 0, false, result.half_carry, result.carry});
                     };
@@ -678,8 +659,6 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // ADD A, u8
@@ -701,19 +680,18 @@ namespace gameboy::cpu {
     };
 
     // ADD rr, i8
-    template<>
-    struct Add<Instruction::Operand::reg16, Instruction::Operand::i8> {
-        Add(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Add<Instruction::Operand::reg16, Instruction::Operand::i8, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::int8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 0:
                     temp = mmu.read_byte(regs.program_counter++);
                     return {};
                 case 1: {
-                        AluResult result{add(rr.get(), temp)};
-                        rr.get() = result.output;
+                        AluResult result{add(R1::get(regs), static_cast<std::int8_t>(temp))};
+                        R1::get(regs) = result.output;
                         adjust_flag(regs, {false, false, result.half_carry, result.carry});
                     }
                     return {};
@@ -721,20 +699,17 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // ADD rr, rr
-    template<>
-    struct Add<Instruction::Operand::reg16, Instruction::Operand::reg16> {
-        Add(Reg16Ref reg1, Reg16Ref reg2) : rr1{reg1}, rr2{reg2} {}
+    template<typename R1, typename R2>
+    struct Add<Instruction::Operand::reg16, Instruction::Operand::reg16, R1, R2> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus&)
         {
             switch (cycle) {
                 case 0: {
-                        AluResult result{add<std::uint16_t>(rr1.get(), rr2.get())};
-                        rr1.get() = result.output;
+                        AluResult result{add<std::uint16_t>(R1::get(regs), R2::get(regs))};
+                        R1::get(regs) = result.output;
                         adjust_flag(regs, {{}, false, result.half_carry, result.carry});
                     }
                     return {};
@@ -742,40 +717,31 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr1;
-        Reg16Ref rr2;
     };
 
     // ADC
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct Adc;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct Adc;
 
     // ADC A, r
-    template<>
-    struct Adc<Instruction::Operand::reg8, Instruction::Operand::reg8> {
-        Adc(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        Adc(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<typename R1>
+    struct Adc<Instruction::Operand::reg8, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult result{add(regs.af.get_high(), (rr.get().*read)(), regs[Flag::carry])};
+            AluResult result{add(regs.af.get_high(), R1::read(regs), regs[Flag::carry])};
             regs.af.set_high(result.output);
             adjust_flag(regs, {result.output == 0, false, result.half_carry, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
     // ADC A, (rr)
-    template<>
-    struct Adc<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        Adc(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Adc<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
             case 0: {
-                    AluResult result{add(regs.af.get_high(), mmu.read_byte(rr.get()), regs[Flag::carry])};
+                    AluResult result{add(regs.af.get_high(), mmu.read_byte(R1::get(regs)), regs[Flag::carry])};
                     regs.af.set_high(result.output);
                     adjust_flag(regs, {result.output == 0, false, result.half_carry, result.carry});
                 };
@@ -784,8 +750,6 @@ namespace gameboy::cpu {
                 return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // ADC A, u8
@@ -807,34 +771,28 @@ namespace gameboy::cpu {
     };
 
     // SUB
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct Sub;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct Sub;
 
     // SUB A, r
-    template<>
-    struct Sub<Instruction::Operand::reg8, Instruction::Operand::reg8> {
-        Sub(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        Sub(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<typename R1>
+    struct Sub<Instruction::Operand::reg8, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult result{sub(regs.af.get_high(), (rr.get().*read)())};
+            AluResult result{sub(regs.af.get_high(), R1::read(regs))};
             regs.af.set_high(result.output);
             adjust_flag(regs, {result.output == 0, true, result.half_carry, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
     // SUB A, (rr)
-    template<>
-    struct Sub<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        Sub(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Sub<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0: {
-                        AluResult result{sub(regs.af.get_high(), mmu.read_byte(rr.get()))};
+                        AluResult result{sub(regs.af.get_high(), mmu.read_byte(R1::get(regs)))};
                         regs.af.set_high(result.output);
                         adjust_flag(regs, {result.output == 0, true, result.half_carry, result.carry});
                     };
@@ -843,8 +801,6 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // SUB A, u8
@@ -866,34 +822,28 @@ namespace gameboy::cpu {
     };
 
     // SBC
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct Sbc;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct Sbc;
 
     // SBC A, r
-    template<>
-    struct Sbc<Instruction::Operand::reg8, Instruction::Operand::reg8> {
-        Sbc(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        Sbc(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<typename R1>
+    struct Sbc<Instruction::Operand::reg8, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult result{sub(regs.af.get_high(), (rr.get().*read)(), regs[Flag::carry])};
+            AluResult result{sub(regs.af.get_high(), R1::read(regs), regs[Flag::carry])};
             regs.af.set_high(result.output);
             adjust_flag(regs, {result.output == 0, true, result.half_carry, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
     // SBC A, (rr)
-    template<>
-    struct Sbc<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        Sbc(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Sbc<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
             case 0: {
-                    AluResult result{sub(regs.af.get_high(), mmu.read_byte(rr.get()), regs[Flag::carry])};
+                    AluResult result{sub(regs.af.get_high(), mmu.read_byte(R1::get(regs)), regs[Flag::carry])};
                     regs.af.set_high(result.output);
                     adjust_flag(regs, {result.output == 0, true, result.half_carry, result.carry});
                 };
@@ -902,8 +852,6 @@ namespace gameboy::cpu {
                 return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // SBC A, u8
@@ -925,41 +873,33 @@ namespace gameboy::cpu {
     };
 
     // AND
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct And;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct And;
 
     // AND A, r
-    template<>
-    struct And<Instruction::Operand::reg8, Instruction::Operand::reg8> {
-        And(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        And(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<typename R1>
+    struct And<Instruction::Operand::reg8, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            regs.af.set_high(regs.af.get_high() & (rr.get().*read)());
+            regs.af.set_high(regs.af.get_high() & R1::read(regs));
             adjust_flag(regs, {regs.af.get_high() == 0, false, true, false});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
     // AND A, (rr)
-    template<>
-    struct And<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        And(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct And<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    regs.af.set_high(regs.af.get_high() & mmu.read_byte(rr.get()));
+                    regs.af.set_high(regs.af.get_high() & mmu.read_byte(R1::get(regs)));
                     adjust_flag(regs, {regs.af.get_high() == 0, false, true, false});
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // AND A, u8
@@ -979,41 +919,33 @@ namespace gameboy::cpu {
     };
 
     // XOR
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct Xor;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct Xor;
 
     // XOR A, r
-    template<>
-    struct Xor<Instruction::Operand::reg8, Instruction::Operand::reg8> {
-        Xor(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        Xor(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<typename R1>
+    struct Xor<Instruction::Operand::reg8, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            regs.af.set_high(regs.af.get_high() ^ (rr.get().*read)());
+            regs.af.set_high(regs.af.get_high() ^ R1::read(regs));
             adjust_flag(regs, {regs.af.get_high() == 0, false, false, false});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
     // XOR A, (rr)
-    template<>
-    struct Xor<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        Xor(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Xor<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    regs.af.set_high(regs.af.get_high() ^ mmu.read_byte(rr.get()));
+                    regs.af.set_high(regs.af.get_high() ^ mmu.read_byte(R1::get(regs)));
                     adjust_flag(regs, {regs.af.get_high() == 0, false, false, false});
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // XOR A, u8
@@ -1033,41 +965,33 @@ namespace gameboy::cpu {
     };
 
     // OR
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct Or;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct Or;
 
     // OR A, r
-    template<>
-    struct Or<Instruction::Operand::reg8, Instruction::Operand::reg8> {
-        Or(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        Or(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<typename R1>
+    struct Or<Instruction::Operand::reg8, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            regs.af.set_high(regs.af.get_high() | (rr.get().*read)());
+            regs.af.set_high(regs.af.get_high() | R1::read(regs));
             adjust_flag(regs, {regs.af.get_high() == 0, false, false, false});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
     // OR A, (rr)
-    template<>
-    struct Or<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        Or(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Or<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    regs.af.set_high(regs.af.get_high() | mmu.read_byte(rr.get()));
+                    regs.af.set_high(regs.af.get_high() | mmu.read_byte(R1::get(regs)));
                     adjust_flag(regs, {regs.af.get_high() == 0, false, false, false});
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // OR A, u8
@@ -1087,33 +1011,27 @@ namespace gameboy::cpu {
     };
 
     // CP: compare
-    template<Instruction::Operand Op1, Instruction::Operand Op2> struct Cp;
+    template<Instruction::Operand Op1, Instruction::Operand Op2, typename R1 = void, typename R2 = void> struct Cp;
 
     // CP A, r
-    template<>
-    struct Cp<Instruction::Operand::reg8, Instruction::Operand::reg8> {
-        Cp(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        Cp(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<typename R1>
+    struct Cp<Instruction::Operand::reg8, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult result{sub(regs.af.get_high(), (rr.get().*read)())};
+            AluResult result{sub(regs.af.get_high(), R1::read(regs))};
             adjust_flag(regs, {result.output == 0, true, result.half_carry, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
     // CP A, (rr)
-    template<>
-    struct Cp<Instruction::Operand::reg8, Instruction::Operand::reg16_address> {
-        Cp(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Cp<Instruction::Operand::reg8, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0: {
-                        AluResult result{sub(regs.af.get_high(), mmu.read_byte(rr.get()))};
+                        AluResult result{sub(regs.af.get_high(), mmu.read_byte(R1::get(regs)))};
                         adjust_flag(regs, {result.output == 0, true, result.half_carry, result.carry});
                     }
                     return {};
@@ -1121,8 +1039,6 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // CP A, u8
@@ -1226,62 +1142,53 @@ namespace gameboy::cpu {
     };
 
     // POP
-    template<bool Reg16ContainsFlag>
+    template<bool Reg16ContainsFlag, typename R1>
     struct Pop {
-        Pop(Reg16Ref reg1) : rr{reg1} {}
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
                     if constexpr (Reg16ContainsFlag) {
-                        rr.get().set_low(FlagRegister{mmu.read_byte(regs.sp++)});
+                        R1::get(regs).set_low(FlagRegister{mmu.read_byte(regs.sp++)});
                     }
                     else {
-                        rr.get().set_low(mmu.read_byte(regs.sp++));
+                        R1::get(regs).set_low(mmu.read_byte(regs.sp++));
                     }
                     return {};
                 case 1:
-                    rr.get().set_high(mmu.read_byte(regs.sp++));
+                    R1::get(regs).set_high(mmu.read_byte(regs.sp++));
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // PUSH
-    template<bool Reg16ContainsFlag>
+    template<bool Reg16ContainsFlag, typename R1>
     struct Push {
-        Push(Reg16Ref reg1) : rr{reg1} {}
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 1:
-                    mmu.write_byte(--regs.sp, rr.get().get_high());
+                    mmu.write_byte(--regs.sp, R1::get(regs).get_high());
                     return {};
                 case 2:
                     if constexpr (Reg16ContainsFlag) {
-                        mmu.write_byte(--regs.sp, rr.get().get_low<FlagRegister>().data());
+                        mmu.write_byte(--regs.sp, R1::get(regs).template get_low<FlagRegister>().data());
                     }
                     else {
-                        mmu.write_byte(--regs.sp, rr.get().get_low<std::uint8_t>());
+                        mmu.write_byte(--regs.sp, R1::get(regs).template get_low<std::uint8_t>());
                     }
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // JR
     template<typename CheckCondition, Instruction::Operand Op1> struct Jr;
-    Jr() -> Jr<void, Instruction::Operand::i8>;
-    template<typename T>
-    Jr(T) -> Jr<T, Instruction::Operand::i8>;
     void relative_jump(int cycle, Registers& regs, gameboy::io::Bus& mmu);
 
     // JR i8
@@ -1297,13 +1204,12 @@ namespace gameboy::cpu {
     // JR cc, i8
     template<typename CheckCondition>
     struct Jr<CheckCondition, Instruction::Operand::i8> {
-        Jr(CheckCondition cc) : pred{cc} {}
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 1:
                     // Conditional: branching
-                    if (!pred(regs)) {
+                    if (!CheckCondition{}(regs)) {
                         // Skip the jump
                         return {.cycle_adjustment{1}};
                     }
@@ -1313,29 +1219,20 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        CheckCondition pred;
     };
 
     // JP
-    template<typename CheckCondition, Instruction::Operand Op1> struct Jp;
-    Jp() -> Jp<void, Instruction::Operand::u16>;
-    Jp(Reg16Ref) -> Jp<void, Instruction::Operand::reg16>;
-    template<typename T> requires std::predicate<T, Registers&>
-    Jp(T) -> Jp<T, Instruction::Operand::u16>;
+    template<typename CheckCondition, Instruction::Operand Op1, typename R1 = void> struct Jp;
     void jump(int cycle, Registers& regs, gameboy::io::Bus& mmu);
 
     // JP rr
-    template<>
-    struct Jp<void, Instruction::Operand::reg16> {
-        Jp(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Jp<void, Instruction::Operand::reg16, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            regs.program_counter = rr.get();
+            regs.program_counter = R1::get(regs);
             return {};
         }
-    private:
-        Reg16Ref rr;
     };
 
     // JP u16
@@ -1351,13 +1248,12 @@ namespace gameboy::cpu {
     // JP cc, u16
     template<typename CheckCondition>
     struct Jp<CheckCondition, Instruction::Operand::u16> {
-        Jp(CheckCondition cc) : pred{cc} {}
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 2:
                     // Conditional: branching
-                    if (!pred(regs)) {
+                    if (!CheckCondition{}(regs)) {
                         // Skip the jump
                         return {.cycle_adjustment{1}};
                     }
@@ -1367,13 +1263,10 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        CheckCondition pred;
     };
 
     // RET
     template<typename CheckCondition> struct Ret;
-    Ret() -> Ret<void>;
     void ret(int cycle, Registers& regs, gameboy::io::Bus& mmu);
 
     // RET
@@ -1389,12 +1282,11 @@ namespace gameboy::cpu {
     // RET cc
     template<typename CheckCondition>
     struct Ret {
-        Ret(CheckCondition cc) : pred{cc} {}
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 0:
-                    if (!pred(regs)) {
+                    if (!CheckCondition{}(regs)) {
                         return {.cycle_adjustment{3}};
                     }
                     return {};
@@ -1407,8 +1299,6 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        CheckCondition pred;
     };
 
     // RETI
@@ -1422,9 +1312,6 @@ namespace gameboy::cpu {
 
     // CALL
     template<typename CheckCondition, Instruction::Operand Op1> struct Call;
-    Call() -> Call<void, Instruction::Operand::u16>;
-    template<typename T>
-    Call(T) -> Call<T, Instruction::Operand::u16>;
     void call(int cycle, Registers& regs, gameboy::io::Bus& mmu);
 
     // CALL u16
@@ -1440,13 +1327,12 @@ namespace gameboy::cpu {
     // CALL cc, u16
     template<typename CheckCondition>
     struct Call<CheckCondition, Instruction::Operand::u16> {
-        Call(CheckCondition cc) : pred{cc} {}
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
             switch (cycle) {
                 case 2:
                     // Conditional: branching
-                    if (!pred(regs)) {
+                    if (!CheckCondition{}(regs)) {
                         // Skip the jump
                         return {.cycle_adjustment{3}};
                     }
@@ -1456,8 +1342,6 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        CheckCondition pred;
     };
 
     // RST: restart
@@ -1484,40 +1368,33 @@ namespace gameboy::cpu {
     };
 
     // RLC: rotate left with carry
-    template<Instruction::Operand op1> struct Rlc;
+    template<Instruction::Operand Op1, typename R1 = void> struct Rlc;
 
     // RLC r
-    template<>
-    struct Rlc<Instruction::Operand::reg8> {
-        Rlc(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Rlc(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
+    template<typename R1>
+    struct Rlc<Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult<std::uint8_t> result{rotate_left_c((rr.get().*read)())};
-            (rr.get().*write)(result.output);
+            AluResult<std::uint8_t> result{rotate_left_c(R1::read(regs))};
+            R1::write(regs, result.output);
             adjust_flag(regs, {result.output == 0, false, false, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // RLC (rr)
-    template<>
-    struct Rlc<Instruction::Operand::reg16_address> {
-        Rlc(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Rlc<Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     return {};
                 case 2: {
                         AluResult<std::uint8_t> result{rotate_left_c(temp)};
-                        mmu.write_byte(rr.get(), result.output);
+                        mmu.write_byte(R1::get(regs), result.output);
                         adjust_flag(regs, {result.output == 0, false, false, result.carry});
                     }
                     return {};
@@ -1525,45 +1402,36 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // RRC: rotate right with carry
-    template<Instruction::Operand op1> struct Rrc;
+    template<Instruction::Operand Op1, typename R1 = void> struct Rrc;
 
     // RRC r
-    template<>
-    struct Rrc<Instruction::Operand::reg8> {
-        Rrc(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Rrc(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
+    template<typename R1>
+    struct Rrc<Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult<std::uint8_t> result{rotate_right_c((rr.get().*read)())};
-            (rr.get().*write)(result.output);
+            AluResult<std::uint8_t> result{rotate_right_c(R1::read(regs))};
+            R1::write(regs, result.output);
             adjust_flag(regs, {result.output == 0, false, false, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // RRC (rr)
-    template<>
-    struct Rrc<Instruction::Operand::reg16_address> {
-        Rrc(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Rrc<Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     return {};
                 case 2: {
                         AluResult<std::uint8_t> result{rotate_right_c(temp)};
-                        mmu.write_byte(rr.get(), result.output);
+                        mmu.write_byte(R1::get(regs), result.output);
                         adjust_flag(regs, {result.output == 0, false, false, result.carry});
                     }
                     return {};
@@ -1571,45 +1439,36 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // RL: rotate left
-    template<Instruction::Operand op1> struct Rl;
+    template<Instruction::Operand Op1, typename R1 = void> struct Rl;
 
     // RL r
-    template<>
-    struct Rl<Instruction::Operand::reg8> {
-        Rl(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Rl(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
+    template<typename R1>
+    struct Rl<Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult<std::uint8_t> result{rotate_left((rr.get().*read)(), regs[Flag::carry])};
-            (rr.get().*write)(result.output);
+            AluResult<std::uint8_t> result{rotate_left(R1::read(regs), regs[Flag::carry])};
+            R1::write(regs, result.output);
             adjust_flag(regs, {result.output == 0, false, false, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // RL (rr)
-    template<>
-    struct Rl<Instruction::Operand::reg16_address> {
-        Rl(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Rl<Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     return {};
                 case 2: {
                         AluResult<std::uint8_t> result{rotate_left(temp, regs[Flag::carry])};
-                        mmu.write_byte(rr.get(), result.output);
+                        mmu.write_byte(R1::get(regs), result.output);
                         adjust_flag(regs, {result.output == 0, false, false, result.carry});
                     }
                     return {};
@@ -1617,45 +1476,36 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // RR: rotate right
-    template<Instruction::Operand op1> struct Rr;
+    template<Instruction::Operand Op1, typename R1 = void> struct Rr;
 
     // RR r
-    template<>
-    struct Rr<Instruction::Operand::reg8> {
-        Rr(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Rr(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
+    template<typename R1>
+    struct Rr<Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult<std::uint8_t> result{rotate_right((rr.get().*read)(), regs[Flag::carry])};
-            (rr.get().*write)(result.output);
+            AluResult<std::uint8_t> result{rotate_right(R1::read(regs), regs[Flag::carry])};
+            R1::write(regs, result.output);
             adjust_flag(regs, {result.output == 0, false, false, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // RR (rr)
-    template<>
-    struct Rr<Instruction::Operand::reg16_address> {
-        Rr(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Rr<Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     return {};
                 case 2: {
                         AluResult<std::uint8_t> result{rotate_right(temp, regs[Flag::carry])};
-                        mmu.write_byte(rr.get(), result.output);
+                        mmu.write_byte(R1::get(regs), result.output);
                         adjust_flag(regs, {result.output == 0, false, false, result.carry});
                     }
                     return {};
@@ -1663,45 +1513,36 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // SLA: shift left arithmetic
-    template<Instruction::Operand op1> struct Sla;
+    template<Instruction::Operand Op1, typename R1 = void> struct Sla;
 
     // SLA r
-    template<>
-    struct Sla<Instruction::Operand::reg8> {
-        Sla(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Sla(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
+    template<typename R1>
+    struct Sla<Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult<std::uint8_t> result{shift_left((rr.get().*read)())};
-            (rr.get().*write)(result.output);
+            AluResult<std::uint8_t> result{shift_left(R1::read(regs))};
+            R1::write(regs, result.output);
             adjust_flag(regs, {result.output == 0, false, false, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // SLA (rr)
-    template<>
-    struct Sla<Instruction::Operand::reg16_address> {
-        Sla(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Sla<Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     return {};
                 case 2: {
                         AluResult<std::uint8_t> result{shift_left(temp)};
-                        mmu.write_byte(rr.get(), result.output);
+                        mmu.write_byte(R1::get(regs), result.output);
                         adjust_flag(regs, {result.output == 0, false, false, result.carry});
                     }
                     return {};
@@ -1709,45 +1550,36 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // SRA: shift right arithmetic
-    template<Instruction::Operand op1> struct Sra;
+    template<Instruction::Operand Op1, typename R1 = void> struct Sra;
 
     // SRA r
-    template<>
-    struct Sra<Instruction::Operand::reg8> {
-        Sra(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Sra(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
+    template<typename R1>
+    struct Sra<Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult<std::uint8_t> result{shift_right_a((rr.get().*read)())};
-            (rr.get().*write)(result.output);
+            AluResult<std::uint8_t> result{shift_right_a(R1::read(regs))};
+            R1::write(regs, result.output);
             adjust_flag(regs, {result.output == 0, false, false, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // SRA (rr)
-    template<>
-    struct Sra<Instruction::Operand::reg16_address> {
-        Sra(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Sra<Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     return {};
                 case 2: {
                         AluResult<std::uint8_t> result{shift_right_a(temp)};
-                        mmu.write_byte(rr.get(), result.output);
+                        mmu.write_byte(R1::get(regs), result.output);
                         adjust_flag(regs, {result.output == 0, false, false, result.carry});
                     }
                     return {};
@@ -1755,45 +1587,36 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // SWAP
-    template<Instruction::Operand op1> struct Swap;
+    template<Instruction::Operand Op1, typename R1 = void> struct Swap;
 
     // SWAP r
-    template<>
-    struct Swap<Instruction::Operand::reg8> {
-        Swap(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Swap(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
+    template<typename R1>
+    struct Swap<Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult<std::uint8_t> result{swap((rr.get().*read)())};
-            (rr.get().*write)(result.output);
+            AluResult<std::uint8_t> result{swap(R1::read(regs))};
+            R1::write(regs, result.output);
             adjust_flag(regs, {result.output == 0, false, false, false});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // SWAP (rr)
-    template<>
-    struct Swap<Instruction::Operand::reg16_address> {
-        Swap(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Swap<Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     return {};
                 case 2: {
                         AluResult<std::uint8_t> result{swap(temp)};
-                        mmu.write_byte(rr.get(), result.output);
+                        mmu.write_byte(R1::get(regs), result.output);
                         adjust_flag(regs, {result.output == 0, false, false, false});
                     }
                     return {};
@@ -1801,45 +1624,36 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // SRL: shift right logical
-    template<Instruction::Operand op1> struct Srl;
+    template<Instruction::Operand Op1, typename R1 = void> struct Srl;
 
     // SRL r
-    template<>
-    struct Srl<Instruction::Operand::reg8> {
-        Srl(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Srl(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
+    template<typename R1>
+    struct Srl<Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            AluResult<std::uint8_t> result{shift_right_l((rr.get().*read)())};
-            (rr.get().*write)(result.output);
+            AluResult<std::uint8_t> result{shift_right_l(R1::read(regs))};
+            R1::write(regs, result.output);
             adjust_flag(regs, {result.output == 0, false, false, result.carry});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
     // SRL (rr)
-    template<>
-    struct Srl<Instruction::Operand::reg16_address> {
-        Srl(Reg16Ref reg1) : rr{reg1} {}
+    template<typename R1>
+    struct Srl<Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     return {};
                 case 2: {
                         AluResult<std::uint8_t> result{shift_right_l(temp)};
-                        mmu.write_byte(rr.get(), result.output);
+                        mmu.write_byte(R1::get(regs), result.output);
                         adjust_flag(regs, {result.output == 0, false, false, result.carry});
                     }
                     return {};
@@ -1847,37 +1661,29 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // BIT: test the bit
-    template<int N, Instruction::Operand Op1> struct Bit;
+    template<int N, Instruction::Operand Op1, typename R1 = void> struct Bit;
 
-    template<int N>
-    struct Bit<N, Instruction::Operand::reg8> {
-        Bit(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter} {}
-        Bit(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter} {}
+    template<int N, typename R1>
+    struct Bit<N, Instruction::Operand::reg8, R1> {
         Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            auto result{static_cast<std::uint8_t>((rr.get().*read)() & (1 << N))};
+            auto result{static_cast<std::uint8_t>(R1::read(regs) & (1 << N))};
             adjust_flag(regs, {result == 0, false, true, {}});
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
     };
 
-    template<int N>
-    struct Bit<N, Instruction::Operand::reg16_address> {
-        Bit(Reg16Ref reg1) : rr{reg1} {}
+    template<int N, typename R1>
+    struct Bit<N, Instruction::Operand::reg16_address, R1> {
         Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1: {
-                        temp = mmu.read_byte(rr.get());
+                        temp = mmu.read_byte(R1::get(regs));
                         auto result{static_cast<std::uint8_t>(temp & (1 << N))};
                         adjust_flag(regs, {result == 0, false, true, {}});
                     }
@@ -1886,90 +1692,70 @@ namespace gameboy::cpu {
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // RES: reset the bit
-    template<int N, Instruction::Operand Op1> struct Res;
+    template<int N, Instruction::Operand Op1, typename R1 = void> struct Res;
 
-    template<int N>
-    struct Res<N, Instruction::Operand::reg8> {
-        Res(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Res(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Instruction::SideEffect operator()(int, Registers&, gameboy::io::Bus&)
+    template<int N, typename R1>
+    struct Res<N, Instruction::Operand::reg8, R1> {
+        Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            auto result{static_cast<std::uint8_t>((rr.get().*read)() & ~(1 << N))};
-            (rr.get().*write)(result);
+            auto result{static_cast<std::uint8_t>(R1::read(regs) & ~(1 << N))};
+            R1::write(regs, result);
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
-    template<int N>
-    struct Res<N, Instruction::Operand::reg16_address> {
-        Res(Reg16Ref reg1) : rr{reg1} {}
-        Instruction::SideEffect operator()(int cycle, Registers&, gameboy::io::Bus& mmu)
+    template<int N, typename R1>
+    struct Res<N, Instruction::Operand::reg16_address, R1> {
+        Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     temp &= ~(1 << N);
                     return {};
                 case 2:
-                    mmu.write_byte(rr.get(), temp);
+                    mmu.write_byte(R1::get(regs), temp);
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 
     // SET: set the bit
-    template<int N, Instruction::Operand Op1> struct Set;
+    template<int N, Instruction::Operand Op1, typename R1 = void> struct Set;
 
-    template<int N>
-    struct Set<N, Instruction::Operand::reg8> {
-        Set(Reg16High reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Set(Reg16Low reg1) : rr{reg1.rr}, read{reg1.getter}, write{reg1.setter} {}
-        Instruction::SideEffect operator()(int, Registers&, gameboy::io::Bus&)
+    template<int N, typename R1>
+    struct Set<N, Instruction::Operand::reg8, R1> {
+        Instruction::SideEffect operator()(int, Registers& regs, gameboy::io::Bus&)
         {
-            auto result{static_cast<std::uint8_t>((rr.get().*read)() | (1 << N))};
-            (rr.get().*write)(result);
+            auto result{static_cast<std::uint8_t>(R1::read(regs) | (1 << N))};
+            R1::write(regs, result);
             return {};
         }
-    private:
-        Reg16Ref rr;
-        Reg8Getter read;
-        Reg8Setter write;
     };
 
-    template<int N>
-    struct Set<N, Instruction::Operand::reg16_address> {
-        Set(Reg16Ref reg1) : rr{reg1} {}
-        Instruction::SideEffect operator()(int cycle, Registers&, gameboy::io::Bus& mmu)
+    template<int N, typename R1>
+    struct Set<N, Instruction::Operand::reg16_address, R1> {
+        Instruction::SideEffect operator()(int cycle, Registers& regs, gameboy::io::Bus& mmu)
         {
-            static std::uint8_t temp{};
+            auto& temp{regs.data_latch};
             switch (cycle) {
                 case 1:
-                    temp = mmu.read_byte(rr.get());
+                    temp = mmu.read_byte(R1::get(regs));
                     temp |= (1 << N);
                     return {};
                 case 2:
-                    mmu.write_byte(rr.get(), temp);
+                    mmu.write_byte(R1::get(regs), temp);
                     return {};
                 default:
                     return {};
             }
         }
-    private:
-        Reg16Ref rr;
     };
 }
 
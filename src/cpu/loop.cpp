@@ -0,0 +1,177 @@
+#include "loop.hpp"
+
+namespace gameboy::cpu {
+    // The length of a jump to an immediate address, or 0 for any other instruction.
+    int jump_length(int opcode)
+    {
+        switch (opcode) {
+            case 0x18:
+            case 0x20:
+            case 0x28:
+            case 0x30:
+            case 0x38:
+                return 2;
+            case 0xC2:
+            case 0xC3:
+            case 0xCA:
+            case 0xD2:
+            case 0xDA:
+                return 3;
+            default:
+                return 0;
+        }
+    }
+
+    /*
+        Whether reading the address has no side effect, and its value can only be changed by a store,
+        an interrupt handler, the host between two runs or an event the other components schedule.
+        DIV, TIMA and the sound registers count on their own, so they don't qualify.
+    */
+    bool is_polled_safely(int address)
+    {
+        return address < 0x8000 ||                         // ROM, which can't switch banks without a store
+            (address >= 0xC000 && address < 0xE000) ||     // WRAM
+            address == 0xFF00 ||                           // P1
+            address == 0xFF06 || address == 0xFF07 ||      // TMA, TAC
+            address == 0xFF0F ||                           // IF
+            (address >= 0xFF40 && address <= 0xFF4B) ||    // LCD, whose STAT and LY change at the events of Lcd::next_event
+            address >= 0xFF80;                             // HRAM, IE
+    }
+
+    // The code in VRAM, OAM or the cartridge RAM could change by itself or isn't worth the trouble.
+    bool is_code_stable(int head, int end)
+    {
+        return end <= 0x8000 || (head >= 0xC000 && end <= 0xE000) || (head >= 0xFF80 && end <= 0xFFFF);
+    }
+
+    bool LoopDetector::observe(std::uint16_t head, std::uint16_t jump, int opcode, const Registers& regs, const io::Bus& bus)
+    {
+        auto end{jump + jump_length(opcode)};
+        if (end == jump || end - head > max_size || !is_code_stable(head, end)) {
+            reset();
+            return false;
+        }
+
+        if (!loop.has_value() || loop->head != head || loop->jump != jump) {
+            loop = analyze(head, jump, end, bus);
+        }
+
+        if (!loop->is_idle) {
+            return false;
+        }
+
+        Snapshot current{regs.af, regs.bc, regs.de, regs.hl, regs.sp, regs.address_latch, regs.data_latch};
+        auto is_repeated{loop->last_registers == current};
+        loop->last_registers = current;
+
+        // The pointers are part of the registers, so they point to the same places in every iteration.
+        auto pointers{loop->pointers};
+        return is_repeated &&
+            ((pointers & bc) == 0 || is_polled_safely(regs.bc)) &&
+            ((pointers & de) == 0 || is_polled_safely(regs.de)) &&
+            ((pointers & hl) == 0 || is_polled_safely(regs.hl)) &&
+            ((pointers & c) == 0 || is_polled_safely(0xFF00 + regs.bc.get_low<std::uint8_t>()));
+    }
+
+    void LoopDetector::reset()
+    {
+        loop.reset();
+    }
+
+    // Decode the body once. It's idle if every instruction only works on the registers or reads memory safely.
+    LoopDetector::Loop LoopDetector::analyze(std::uint16_t head, std::uint16_t jump, int end, const io::Bus& bus)
+    {
+        Loop result{.head{head}, .jump{jump}, .is_idle{false}, .pointers{0}, .last_registers{}};
+
+        auto address{static_cast<int>(head)};
+        auto is_jump_reached{false};
+        while (address < end) {
+            is_jump_reached = is_jump_reached || address == jump;
+
+            auto opcode{bus.read_byte(address)};
+            auto length{1};
+            if (auto size{jump_length(opcode)}; size > 0) {
+                // Leaving the loop is fine, but jumping within it would leave some code unchecked.
+                auto target{size == 2 ?
+                    address + 2 + static_cast<std::int8_t>(bus.read_byte(address + 1)) :
+                    bus.read_byte(address + 1) | (bus.read_byte(address + 2) << 8)};
+                if (target != head && target >= head && target < end) {
+                    return result;
+                }
+
+                length = size;
+            }
+            else if (opcode == 0xF0) {
+                // LDH A, (u8)
+                if (!is_polled_safely(0xFF00 + bus.read_byte(address + 1))) {
+                    return result;
+                }
+
+                length = 2;
+            }
+            else if (opcode == 0xFA) {
+                // LD A, (u16)
+                if (!is_polled_safely(bus.read_byte(address + 1) | (bus.read_byte(address + 2) << 8))) {
+                    return result;
+                }
+
+                length = 3;
+            }
+            else if (opcode == 0xF2) {
+                result.pointers |= c;
+            }
+            else if (opcode == 0x0A) {
+                result.pointers |= bc;
+            }
+            else if (opcode == 0x1A) {
+                result.pointers |= de;
+            }
+            else if (opcode == 0xCB) {
+                auto suffix{bus.read_byte(address + 1)};
+                if ((suffix & 0x07) == 0x06) {
+                    // BIT b, (HL) is the only one which doesn't write (HL) back.
+                    if (suffix < 0x40 || suffix >= 0x80) {
+                        return result;
+                    }
+
+                    result.pointers |= hl;
+                }
+
+                length = 2;
+            }
+            else if (opcode >= 0x40 && opcode < 0xC0) {
+                // LD r, r and the ALU operations, but neither HALT nor LD (HL), r
+                if (opcode >= 0x70 && opcode < 0x78) {
+                    return result;
+                }
+
+                if ((opcode & 0x07) == 0x06) {
+                    result.pointers |= hl;
+                }
+            }
+            else if (opcode < 0x40 && ((opcode & 0x07) == 0x04 || (opcode & 0x07) == 0x05 || (opcode & 0x07) == 0x06)) {
+                // INC r, DEC r and LD r, u8, but not on (HL)
+                if ((opcode >> 3) == 0x06) {
+                    return result;
+                }
+
+                length = (opcode & 0x07) == 0x06 ? 2 : 1;
+            }
+            else if (opcode < 0x40 && ((opcode & 0x07) == 0x07 || (opcode & 0x0F) == 0x03 || (opcode & 0x0F) == 0x0B)) {
+                // rotations of A, DAA, CPL, SCF, CCF, INC rr and DEC rr
+            }
+            else if ((opcode & 0xC7) == 0xC6) {
+                // the ALU operations on an immediate value
+                length = 2;
+            }
+            else if (opcode != 0x00) {
+                return result;
+            }
+
+            address += length;
+        }
+
+        result.is_idle = is_jump_reached && address == end;
+        return result;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef CPU_LOOP_H
+#define CPU_LOOP_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include "io/bus.hpp"
+#include "registers.hpp"
+
+namespace gameboy::cpu {
+    /*
+        Recognizes a short loop which does nothing but read memory and compare it, like
+        `ld a, (ff44); cp 144; jr nz`. Such a loop only polls: it stores nothing and reads nothing
+        that changes by being read, so an iteration which ends with the same registers as the last
+        one will be repeated as it is until another component changes what it reads.
+    */
+    class LoopDetector {
+    public:
+        // Called whenever a jump goes backwards. Whether the loop is idle and has just repeated itself.
+        bool observe(std::uint16_t head, std::uint16_t jump, int opcode, const Registers& regs, const io::Bus& bus);
+        void reset();
+
+        static constexpr int max_size{16}; // bytes from the head to the end of the jump
+    private:
+        enum Pointer {
+            bc = 1 << 0,
+            de = 1 << 1,
+            hl = 1 << 2,
+            c = 1 << 3  // LD A, (FF00+C)
+        };
+
+        using Snapshot = std::array<std::uint16_t, 7>;
+
+        struct Loop {
+            std::uint16_t head;
+            std::uint16_t jump;
+            bool is_idle;
+            int pointers;  // the registers through which the body reads
+            std::optional<Snapshot> last_registers;
+        };
+
+        static Loop analyze(std::uint16_t head, std::uint16_t jump, int end, const io::Bus& bus);
+
+        std::optional<Loop> loop{};
+    };
+}
+
+#endif
\ No newline at end of file
@@ -71,6 +71,10 @@ namespace gameboy::cpu {
         PairedRegister hl{std::uint8_t{}, std::uint8_t{}};
         PairedRegister sp{std::uint8_t{}, std::uint8_t{}}; // stack pointer
         PairedRegister program_counter{std::uint8_t{}, std::uint8_t{}};
+
+        // internal registers holding the operands across m-cycles (inaccessible to programs)
+        PairedRegister address_latch{std::uint8_t{}, std::uint8_t{}};
+        std::uint8_t data_latch{};
     };
 
     void adjust_flag(Registers& flag, FlagAdjustment adjust);
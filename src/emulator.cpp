@@ -1,9 +1,12 @@
 #include "emulator.hpp"
 #include "cartridge/banking.hpp"
-#include "io/bus.hpp"
-#include "system/interrupt.hpp"
+#include <atomic>
 #include <chrono>
+#include <exception>
+#include <iomanip>
 #include <iostream>
+#include <string>
+#include <thread>
 
 namespace gameboy {
     using Clock = std::chrono::steady_clock;
@@ -16,132 +19,180 @@ namespace gameboy {
             ++count;
             sum += static_cast<double>((end - start).count());
         }
-        void show_average() const
+        void show_average()
         {
             constexpr int frequency{100};
             if (count % frequency == 0) {
-                std::cout << "Average execution time per frame: "  << (sum / count) << "\n";
+                // The frame rate is measured against the host clock, so it shows how fast an uncapped run goes.
+                auto now{Clock::now()};
+                std::chrono::duration<double> host_time{now - last_report};
+                last_report = now;
+                std::cout << "Average execution time per frame: "  << (sum / count)
+                    << ", emulated frames per second: " << (frequency / host_time.count()) << "\n";
             }
         }
     private:
         int count{};
         double sum{};
+        Timestamp last_report{Clock::now()};
     };
 
     using namespace ui;
 
-    Emulator::Emulator()
-        : p_game_window{ui::create_window("Money Boy", Width{480}, Height{432})}
-        , p_game_renderer{ui::create_renderer(p_game_window, Scale{3.0}, Scale{3.0})}
-        , p_game_texture{ui::create_texture(p_game_renderer, Width{160}, Height{144})}
+    Emulator::Emulator(ExecutionMode mode, std::size_t budget, ppu::Renderer option, double speed, int skip)
+        : execution_mode{mode}
+        , renderer{option}
+        , target_speed{speed}
+        , frame_skip{skip}
+        , rewind_budget{budget}
+        , p_game_window{ui::create_window("Money Boy", Width{480}, Height{432})}
+        , presenter{p_game_window, Width{160}, Height{144}, Scale{3.0}}
         , audio_device{SDL_AudioSpec{.freq{47662}, .format{AUDIO_F32SYS}, .channels{2}, .samples{4096}, .callback{nullptr}}}
     {
     }
 
     void Emulator::load_game()
     {
-        auto cartridge_memory{cartridge::create_storage("res/Tetris (World) (Rev A).gb")};
+        static const std::string file_name{"res/Tetris (World) (Rev A).gb"};
+
+        std::cout << "Load cartridge: " << file_name << "\n";
+        auto cartridge_memory{cartridge::create_storage(file_name)};
+        std::cout << "ROM size: " << cartridge_memory.rom.size() << "\n";
         auto p_mbc{create_mbc(std::move(cartridge_memory))};
+        std::cout << "Create MBC: " << p_mbc->get_name() << "\n";
 #ifndef PREBOOT
         auto p_boot_loader{std::make_unique<BootLoader>("res/DMG_boot")};
         cartridge::Banking cartridge_banking{std::move(p_boot_loader), std::move(p_mbc)};
 #else
         cartridge::Banking cartridge_banking{std::move(p_mbc)};
 #endif
-        p_interrupt = std::make_unique<system::Interrupt>();
-        p_joypad = std::make_unique<system::Joypad>(*p_interrupt);
-        p_serial = std::make_unique<system::Serial>(*p_interrupt);
-        p_timer = std::make_unique<system::Timer>(*p_interrupt);
-        p_psg = std::make_unique<apu::Psg>();
-        p_lcd = std::make_unique<ppu::Lcd>(*p_interrupt);
-        p_vram = std::make_unique<ppu::Vram>(*p_lcd);
-        p_oam = std::make_unique<ppu::Oam>(*p_lcd);
-
-        io::Bundle peripherals{
-            .cartridge_space{std::move(cartridge_banking)},
-            .vram{*p_vram},
-            .oam{*p_oam},
-            .joypad{*p_joypad},
-            .serial{*p_serial},
-            .timer{*p_timer},
-            .interrupt{*p_interrupt},
-            .psg{*p_psg},
-            .lcd{*p_lcd}
-        };
-        auto p_address_bus{std::make_unique<io::Bus>(std::move(peripherals))};
-
-        p_apu = std::make_unique<apu::Core>(audio_device);
-        p_cpu = std::make_unique<cpu::Core>(std::move(p_address_bus));
-        p_ppu = std::make_unique<ppu::Core>(*p_vram, *p_oam);
+        p_machine = std::make_unique<Machine>(std::move(cartridge_banking), execution_mode);
+        p_machine->set_renderer(renderer);
+        p_rewind = std::make_unique<RewindBuffer>(*p_machine, rewind_budget);
     }
 
     void Emulator::run()
     {
         load_game();
 
-        constexpr int cycles_per_frame{70224};
-        auto sync = [cycles_per_frame](const Timestamp& prev, const Timestamp& current) -> bool {
-            using Seconds = std::chrono::duration<double, std::chrono::seconds::period>;
-            static constexpr double frequency{4.194304e6};
-
-            Seconds seconds_per_frame{(1 / frequency * cycles_per_frame)};
-            return current - prev >= seconds_per_frame;
-        };
+        // SDL wants the window and its renderer on the main thread, so the machine runs on a worker instead.
+        std::exception_ptr failure{};
+        std::atomic<bool> is_finished{false};
+        std::jthread emulation{[this, &failure, &is_finished](std::stop_token token) {
+            try {
+                emulate(token);
+            }
+            catch (...) {
+                failure = std::current_exception();
+            }
+            is_finished.store(true, std::memory_order_release);
+        }};
 
-        Performance checker{};
-        Timestamp prev{Clock::now()};
-        int cycle{};
-        bool quit{false};
-        while (!quit) {
+        while (!is_finished.load(std::memory_order_acquire)) {
             SDL_Event event{};
             while (SDL_PollEvent(&event) != 0) {
                 if (event.type == SDL_QUIT) { // click [×] on the top-right corner
-                    quit = true;
-                }
-                if (event.type == SDL_KEYDOWN) {
-                    process_keystroke<SDL_KEYDOWN>(*p_joypad, event.key.keysym.sym);
+                    emulation.request_stop();
                 }
-                if (event.type == SDL_KEYUP) {
-                    process_keystroke<SDL_KEYUP>(*p_joypad, event.key.keysym.sym);
+                if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) {
+                    std::lock_guard lock{input_mutex};
+                    pending_input.push_back(event.key);
                 }
             }
 
-            if (cycle < cycles_per_frame) {
-                p_timer->tick();
-                p_serial->tick();
-                p_cpu->tick();
+            if (!presenter.present()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+        }
 
-                for (auto i{0}; i < 2; ++i) {
-                    p_apu->tick(*p_psg);
-                }
+        emulation.join();
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
 
-                for (auto i{0}; i < 4; ++i) {
-                    p_ppu->tick(*p_lcd);
-                }
+        std::cout << "Frames presented: " << presenter.get_presented_count()
+            << ", dropped: " << presenter.get_dropped_count()
+            << ", duplicated: " << presenter.get_duplicated_count() << "\n";
+
+        for (const auto& [head, stats] : p_machine->get_idle_loops()) {
+            std::cout << "Idle loop at 0x" << std::hex << std::setw(4) << std::setfill('0') << head
+                << std::dec << std::setfill(' ') << ": skipped " << stats.skips << " times, "
+                << stats.iterations << " iterations, " << stats.cycles << " m-cycles\n";
+        }
+    }
+
+    void Emulator::emulate(std::stop_token token)
+    {
+        using Seconds = std::chrono::duration<double>;
+        static constexpr double frequency{4.194304e6};
+        Seconds seconds_per_frame{Machine::cycles_per_frame / frequency};
 
-                p_lcd->update(*p_game_renderer, *p_game_texture);
-                p_psg->update();
-                p_psg->advance_sequencer(p_timer->get_divider());
+        // Don't let the audio fall further behind when the game runs faster than real time.
+        static constexpr Uint32 max_queued_audio{47662 * 2 * sizeof(float) / 4}; // a quarter of a second
 
-                for (auto i{0}; i < 4; ++i) {
-                    p_psg->advance_waveform();
+        FramePacer pacer{std::chrono::duration_cast<FramePacer::Clock::duration>(seconds_per_frame), target_speed};
+        Performance checker{};
+        std::vector<SDL_KeyboardEvent> input{};
+        std::size_t printed_output{0};
+        std::uint64_t frame_count{0};
+        std::uint64_t posted_frame{0};
+        bool rewinding{false}; // hold R to go back in time
+        while (!token.stop_requested()) {
+            {
+                std::lock_guard lock{input_mutex};
+                input.swap(pending_input);
+            }
+            for (const auto& key : input) {
+                if (key.type == SDL_KEYDOWN) {
+                    process_keystroke<SDL_KEYDOWN>(p_machine->get_joypad(), key.keysym.sym);
+                    rewinding |= key.keysym.sym == SDL_KeyCode::SDLK_r;
+                    if (key.keysym.sym == SDL_KeyCode::SDLK_TAB) { // hold Tab to fast-forward
+                        pacer.set_speed(FramePacer::unbounded);
+                    }
+                }
+                if (key.type == SDL_KEYUP) {
+                    process_keystroke<SDL_KEYUP>(p_machine->get_joypad(), key.keysym.sym);
+                    if (key.keysym.sym == SDL_KeyCode::SDLK_TAB) {
+                        pacer.set_speed(target_speed);
+                    }
+                    if (key.keysym.sym == SDL_KeyCode::SDLK_r) {
+                        rewinding = false;
+                        std::cout << "Rewind: " << p_rewind->get_frame_count() << " frames kept in "
+                            << (p_rewind->get_used_bytes() >> 10) << " of " << (p_rewind->get_budget() >> 10) << " KiB\n";
+                    }
                 }
             }
+            input.clear();
 
-            cycle += 4;
-
-            if (cycle >= cycles_per_frame) {
-                Timestamp current{Clock::now()};
-                if (cycle == cycles_per_frame) {
-                    checker.add_frame(prev, current);
-                    checker.show_average();
+            if (rewinding) {
+                p_rewind->rewind(*p_machine, 1);
+                presenter.post(p_machine->get_frame());
+            }
+            else {
+                auto start{Clock::now()};
+                p_machine->set_drawing(frame_count++ % (frame_skip + 1) == 0);
+                p_machine->step_frame();
+                p_rewind->record(*p_machine);
+                if (p_machine->get_completed_frames() != posted_frame) {
+                    posted_frame = p_machine->get_completed_frames();
+                    presenter.post(p_machine->get_frame());
                 }
-
-                if (sync(prev, current)) {
-                    prev = current;
-                    cycle = 0;
+                if (SDL_GetQueuedAudioSize(audio_device.get_id()) < max_queued_audio) {
+                    ui::play_sound(audio_device.get_id(), p_machine->get_audio_samples());
                 }
+
+                auto serial_output{p_machine->get_serial_output()};
+                std::cout << serial_output.substr(printed_output) << std::flush;
+                printed_output = serial_output.size();
+
+                checker.add_frame(start, Clock::now());
+                checker.show_average();
             }
+
+            pacer.wait();
         }
+
+        std::cout << "Average frame drift: " << std::chrono::duration_cast<std::chrono::microseconds>(pacer.get_average_drift()).count()
+            << " us, resynchronized " << pacer.get_resync_count() << " times\n";
     }
 }
\ No newline at end of file
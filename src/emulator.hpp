@@ -2,39 +2,52 @@
 #define EMULATOR_H
 
 #include <memory>
-#include "cpu/core.hpp"
-#include "ppu/core.hpp"
-#include "ppu/lcd.hpp"
-#include "ppu/oam.hpp"
-#include "ppu/vram.hpp"
-#include "system/interrupt.hpp"
+#include <mutex>
+#include <stop_token>
+#include <vector>
+#include "machine.hpp"
+#include "rewind.hpp"
 #include "system/joypad.hpp"
-#include "system/serial.hpp"
-#include "system/timer.hpp"
 #include "ui/display.hpp"
+#include "ui/pacer.hpp"
+#include "ui/presenter.hpp"
+#include "ui/sound.hpp"
 #include "ui/wrapper.hpp"
 
 namespace gameboy {
     class Emulator : private ui::SdlWrapper {
     public:
-        explicit Emulator();
+        using ExecutionMode = Machine::ExecutionMode;
+
+        static constexpr std::size_t default_rewind_budget{32 << 20};
+
+        explicit Emulator(
+            ExecutionMode mode = ExecutionMode::m_cycle,
+            std::size_t budget = default_rewind_budget,
+            ppu::Renderer option = ppu::Renderer::fifo,
+            double speed = 1.0, // ui::FramePacer::unbounded runs as fast as possible
+            int skip = 0        // the frames left undrawn after each drawn one
+        );
         void load_game();
         void save_game();
         void run();
     private:
-        std::unique_ptr<cpu::Core> p_cpu{};
-        std::unique_ptr<system::Interrupt> p_interrupt{};
-        std::unique_ptr<system::Joypad> p_joypad{};
-        std::unique_ptr<system::Serial> p_serial{};
-        std::unique_ptr<system::Timer> p_timer{};
-        std::unique_ptr<ppu::Core> p_ppu{};
-        std::unique_ptr<ppu::Lcd> p_lcd{};
-        std::unique_ptr<ppu::Oam> p_oam{};
-        std::unique_ptr<ppu::Vram> p_vram{};
+        void emulate(std::stop_token token); // on a worker thread, while the main one handles the window
+
+        ExecutionMode execution_mode;
+        ppu::Renderer renderer;
+        double target_speed;
+        int frame_skip;
+        std::unique_ptr<Machine> p_machine{};
+        std::size_t rewind_budget;
+        std::unique_ptr<RewindBuffer> p_rewind{};
 
         ui::WindowPtr p_game_window;
-        ui::RendererPtr p_game_renderer;
-        ui::TexturePtr p_game_texture;
+        ui::Presenter presenter;
+        ui::AudioDevice audio_device;
+
+        std::mutex input_mutex{};
+        std::vector<SDL_KeyboardEvent> pending_input{}; // handed from the main thread to the emulating one
     };
 
     template<SDL_EventType N, bool Pressed = (N == SDL_KEYDOWN)>
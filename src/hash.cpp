@@ -0,0 +1,12 @@
+#include "hash.hpp"
+
+namespace gameboy {
+    std::uint64_t hash_bytes(std::span<const std::uint8_t> bytes, std::uint64_t hash)
+    {
+        for (auto byte : bytes) {
+            hash = (hash ^ byte) * 0x0000'0100'0000'01B3;
+        }
+
+        return hash;
+    }
+}
\ No newline at end of file
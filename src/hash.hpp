@@ -0,0 +1,14 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstdint>
+#include <span>
+
+namespace gameboy {
+    constexpr std::uint64_t initial_hash{0xCBF2'9CE4'8422'2325};
+
+    // FNV-1a, continued from the given hash, e.g. to compare frames without keeping them
+    std::uint64_t hash_bytes(std::span<const std::uint8_t> bytes, std::uint64_t hash = initial_hash);
+}
+
+#endif
\ No newline at end of file
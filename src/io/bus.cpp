@@ -1,6 +1,4 @@
 #include "bus.hpp"
-#include <cassert>
-#include <stdexcept>
 
 namespace gameboy::io {
     void dma_transfer(Bus& bus, std::uint8_t source)
@@ -15,32 +13,146 @@ namespace gameboy::io {
     Bus::Bus(Bundle bundle) : peripherals{std::move(bundle)}
     {
         work_ram.resize(0xE000 - 0xC000);
-        ports.resize(0xFF80 - 0xFF00);
         high_ram.resize(0xFFFF - 0xFF80);
         //ram[0xFF44] = 144; // bypass frame check
+
+        // Writes go through Vram to keep its decoded tiles up to date and to let the PPU see them coming.
+        auto* p_vram{peripherals.vram.get().data()};
+        for (auto page{0x80}; page < 0xA0; ++page) {
+            page_table[page] = {p_vram + ((page - 0x80) << 8), nullptr};
+        }
+
+        for (auto page{0xC0}; page < 0xFE; ++page) {
+            auto* p_page{work_ram.data() + (((page - 0xC0) << 8) & 0x1FFF)}; // 0xE000-0xFDFF mirrors WRAM
+            page_table[page] = {p_page, p_page};
+        }
+
+        map_cartridge();
+        map_ports();
     }
 
     std::uint8_t Bus::read_byte(int address) const
     {
-        if (address < 0) {
-            throw std::out_of_range{"Negative Address!"};
+        const auto& page{page_table[(address >> 8) & 0xFF]};
+        if (page.read != nullptr) {
+            return page.read[address & 0xFF];
         }
-        else if (address < 0x8000) {
-            return peripherals.cartridge_space.read(address);
+
+        return read_unmapped(address & 0xFFFF);
+    }
+
+    void Bus::write_byte(int address, std::uint8_t value)
+    {
+        const auto& page{page_table[(address >> 8) & 0xFF]};
+        if (page.write != nullptr) {
+            page.write[address & 0xFF] = value;
+            return;
         }
-        else if (address < 0xA000) {
-            return peripherals.vram.get().read(address);
+
+        write_unmapped(address & 0xFFFF, value);
+    }
+
+    void Bus::advance_cartridge(int cycles)
+    {
+        peripherals.cartridge_space.advance(cycles);
+    }
+
+    void Bus::set_synchronizer(std::function<void()> callback)
+    {
+        synchronizer = std::move(callback);
+    }
+
+    system::Interrupt& Bus::get_interrupt()
+    {
+        return peripherals.interrupt;
+    }
+
+    const system::Interrupt& Bus::get_interrupt() const
+    {
+        return peripherals.interrupt;
+    }
+
+    void Bus::save(state::Writer& out) const
+    {
+        out.write_bytes(work_ram);
+        out.write_bytes(high_ram);
+        peripherals.cartridge_space.save(out);
+    }
+
+    void Bus::load(state::Reader& in)
+    {
+        in.read_bytes(work_ram);
+        in.read_bytes(high_ram);
+        peripherals.cartridge_space.load(in);
+        map_cartridge();
+    }
+
+    /*
+        Refresh the pages owned by the cartridge. This must be done whenever the
+        banking changes instead of checking the current bank on every access.
+    */
+    void Bus::map_cartridge()
+    {
+        auto& cartridge_space{peripherals.cartridge_space};
+        for (auto page{0x00}; page < 0x80; ++page) {
+            page_table[page] = {cartridge_space.map(page << 8), nullptr};
         }
-        else if (address < 0xC000) {
-            return peripherals.cartridge_space.read(address);
+
+        for (auto page{0xA0}; page < 0xC0; ++page) {
+            page_table[page] = {cartridge_space.map(page << 8), cartridge_space.map_writable(page << 8)};
         }
-        else if (address < 0xE000) {
-            return work_ram[address - 0xC000];
+    }
+
+    /*
+        Build the handlers of the I/O page. The registers of the peripherals are bound to their
+        accessors, while the rest are open bus: they read as 0xFF and ignore writes.
+    */
+    void Bus::map_ports()
+    {
+        port_table.fill(Port{
+            this,
+            [](const void*) { return open_bus; },
+            [](void*, std::uint8_t) {},
+            false
+        });
+
+        peripherals.joypad.get().map_ports(port_table);
+        peripherals.serial.get().map_ports(port_table);
+        peripherals.timer.get().map_ports(port_table);
+        peripherals.interrupt.get().map_ports(port_table);
+        peripherals.psg.get().map_ports(port_table);
+        peripherals.lcd.get().map_ports(port_table);
+
+        auto& dma_port{port_table[0xFF46 - port_base]};
+        lcd_dma = dma_port;
+        dma_port.owner = this;
+        dma_port.write = [](void* p_owner, std::uint8_t value) {
+            auto& bus{*static_cast<Bus*>(p_owner)};
+            bus.lcd_dma.write(bus.lcd_dma.owner, value);
+            dma_transfer(bus, value);
+        };
+        dma_port.read = [](const void* p_owner) {
+            const auto& bus{*static_cast<const Bus*>(p_owner)};
+            return bus.lcd_dma.read(bus.lcd_dma.owner);
+        };
+
+        // Any write to 0xFF50 unmaps the boot ROM for good.
+        port_table[0xFF50 - port_base].write = [](void* p_owner, std::uint8_t) {
+            auto& bus{*static_cast<Bus*>(p_owner)};
+            bus.peripherals.cartridge_space.disable_boot_rom();
+            bus.map_cartridge();
+        };
+    }
+
+    std::uint8_t Bus::read_unmapped(int address) const
+    {
+        if (address < 0x8000) {
+            return peripherals.cartridge_space.read(address);
         }
-        else if (address < 0xFE00) {
-            return work_ram[address - 0xE000]; // mirror
+        else if (address >= 0xA000 && address < 0xC000) {
+            return peripherals.cartridge_space.read(address);
         }
-        else if (address < 0xFEA0) {
+        else if (address >= 0xFE00 && address < 0xFEA0) {
             return peripherals.oam.get().read(address);
         }
         else if (address < 0xFF00) {
@@ -50,59 +162,32 @@ namespace gameboy::io {
             */
             return 0;
         }
-        else if (address == 0xFF00) {
-            return peripherals.joypad.get().read(address);
-        }
-        else if (address >= 0xFF01 && address < 0xFF03) {
-            return peripherals.serial.get().read(address);
-        }
-        else if (address >= 0xFF04 && address < 0xFF08) {
-            return peripherals.timer.get().read(address);
-        }
-        else if (address == 0xFF0F) {
-            return peripherals.interrupt.get().read(address);
-        }
-        else if (address >= 0xFF10 && address < 0xFF40) {
-            return peripherals.psg.get().read(address);
-        }
-        else if (address >= 0xFF40 && address < 0xFF4C) {
-            return peripherals.lcd.get().read(address);
-        }
-        else if (address >= 0xFF00 && address < 0xFF80) {
-            return ports[address - 0xFF00];
+        else if (address < 0xFF80) {
+            return read_port(address);
         }
         else if (address < 0xFFFF) {
             return high_ram[address - 0xFF80];
         }
-        else if (address == 0xFFFF) {
-            return interrupt_enable;
-        }
         else {
-            throw std::out_of_range{"Not Implemented Address Space!"};
+            return peripherals.interrupt.get().get_enable();
         }
     }
 
-    void Bus::write_byte(int address, std::uint8_t value)
+    void Bus::write_unmapped(int address, std::uint8_t value)
     {
-        if (address < 0) {
-            throw std::out_of_range{"Negative Address!"};
-        }
-        else if (address < 0x8000) {
+        if (address < 0x8000) {
             peripherals.cartridge_space.write(address, value);
+            map_cartridge(); // the write may have switched banks
         }
         else if (address < 0xA000) {
+            synchronize_drawing();
             peripherals.vram.get().write(address, value);
         }
-        else if (address < 0xC000) {
+        else if (address >= 0xA000 && address < 0xC000) {
             peripherals.cartridge_space.write(address, value);
         }
-        else if (address < 0xE000) {
-            work_ram[address - 0xC000] = value;
-        }
-        else if (address < 0xFE00) {
-            throw std::out_of_range{"This address is the mirror of WRAM."};
-        }
-        else if (address < 0xFEA0) {
+        else if (address >= 0xFE00 && address < 0xFEA0) {
+            synchronize_drawing();
             peripherals.oam.get().write(address, value);
         }
         else if (address < 0xFF00) {
@@ -111,45 +196,49 @@ namespace gameboy::io {
                 in some games and may cause OAM corruption on real hardware.
             */
         }
-        else if (address == 0xFF00) {
-            peripherals.joypad.get().write(address, value);
-        }
-        else if (address >= 0xFF01 && address < 0xFF03) {
-            peripherals.serial.get().write(address, value);
-        }
-        else if (address >= 0xFF04 && address < 0xFF08) {
-            peripherals.timer.get().write(address, value);
-        }
-        else if (address == 0xFF0F) {
-            peripherals.interrupt.get().write(address, value);
-        }
-        else if (address >= 0xFF10 && address < 0xFF40) {
-            peripherals.psg.get().write(address, value);
-        }
-        else if (address == 0xFF46) {
-            peripherals.lcd.get().write(address, value);
-            dma_transfer(*this, value);
-        }
-        else if (address >= 0xFF40 && address < 0xFF4C) {
-            peripherals.lcd.get().write(address, value);
-        }
-        else if (address == 0xFF50) {
-            peripherals.cartridge_space.disable_boot_rom();
-        }
-        else if (address >= 0xFF00 && address < 0xFF80) {
-            ports[address - 0xFF00] = value;
+        else if (address < 0xFF80) {
+            write_port(address, value);
         }
         else if (address < 0xFFFF) {
             high_ram[address - 0xFF80] = value;
         }
-        else if (address == 0xFFFF) {
-            interrupt_enable = value;
-        }
         else {
-            throw std::out_of_range{"Not Implemented Address Space!"};
+            peripherals.interrupt.get().set_enable(value);
+        }
+    }
+
+    // The PPU reads the VRAM and the OAM while it draws, so it has to be at the same dot as the CPU when they change.
+    void Bus::synchronize_drawing()
+    {
+        if (synchronizer && peripherals.lcd.get().is_enabled()) {
+            synchronizer();
         }
     }
 
+    std::uint8_t Bus::read_port(int address) const
+    {
+        const auto& port{port_table[address - port_base]};
+        if (port.is_scheduled && synchronizer) {
+            synchronizer();
+        }
+
+        return port.read(port.owner);
+    }
+
+    void Bus::write_port(int address, std::uint8_t value)
+    {
+        const auto& port{port_table[address - port_base]};
+        if (port.is_scheduled && synchronizer) {
+            // Catch up before the write takes effect, then let the components reschedule.
+            synchronizer();
+            port.write(port.owner, value);
+            synchronizer();
+            return;
+        }
+
+        port.write(port.owner, value);
+    }
+
     int make_address(std::uint8_t high, std::int8_t low)
     {
         return (high << 8) | low;
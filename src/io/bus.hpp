@@ -1,26 +1,33 @@
 #ifndef IO_BUS_H
 #define IO_BUS_H
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <string>
 #include "apu/psg.hpp"
 #include "cartridge/banking.hpp"
+#include "ppu/lcd.hpp"
 #include "ppu/oam.hpp"
 #include "ppu/vram.hpp"
 #include "port.hpp"
+#include "state.hpp"
+#include "system/interrupt.hpp"
+#include "system/joypad.hpp"
+#include "system/serial.hpp"
+#include "system/timer.hpp"
 
 namespace gameboy::io {
     struct Bundle {
         cartridge::Banking cartridge_space;
         std::reference_wrapper<ppu::Vram> vram;
         std::reference_wrapper<ppu::Oam> oam;
-        std::reference_wrapper<Port> joypad;
-        std::reference_wrapper<Port> serial;
-        std::reference_wrapper<Port> timer;
-        std::reference_wrapper<Port> interrupt;
-        std::reference_wrapper<Port> psg;
-        std::reference_wrapper<Port> lcd;
+        std::reference_wrapper<system::Joypad> joypad;
+        std::reference_wrapper<system::Serial> serial;
+        std::reference_wrapper<system::Timer> timer;
+        std::reference_wrapper<system::Interrupt> interrupt;
+        std::reference_wrapper<apu::Psg> psg;
+        std::reference_wrapper<ppu::Lcd> lcd;
     };
 
     class Bus {
@@ -28,16 +35,47 @@ namespace gameboy::io {
         Bus(Bundle bundle);
         std::uint8_t read_byte(int address) const;
         void write_byte(int address, std::uint8_t value);
+
+        // Let the cartridge keep pace with the emulated clock cycles, see cartridge::Mbc::advance.
+        void advance_cartridge(int cycles);
+
+        // The callback brings the components up to date before their registers are accessed.
+        void set_synchronizer(std::function<void()> callback);
+
+        // For the CPU to handle the interrupts without going through the addresses.
+        system::Interrupt& get_interrupt();
+        const system::Interrupt& get_interrupt() const;
+
+        // The memory owned by the bus and the cartridge.
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
     private:
+        struct Page {
+            const std::uint8_t* read{}; // nullptr: dispatch by address
+            std::uint8_t* write{};      // nullptr: dispatch by address
+        };
+
+        void map_cartridge();
+        void map_ports();
+        std::uint8_t read_unmapped(int address) const;
+        void write_unmapped(int address, std::uint8_t value);
+        std::uint8_t read_port(int address) const;
+        void write_port(int address, std::uint8_t value);
+        void synchronize_drawing();
+
         Bundle peripherals;
         std::vector<std::uint8_t> work_ram{}; // 0xC000-0xDFFF
 
         /* Echo RAM */                        // 0xE000-0xFDFF
 
         /* Unused */                          // 0xFEA0-0xFEFF
-        std::vector<std::uint8_t> ports{};    // 0xFF00-0xFF7F
+        PortTable port_table{};               // 0xFF00-0xFF7F
         std::vector<std::uint8_t> high_ram{}; // 0xFF80-0xFFFE
-        std::uint8_t interrupt_enable{};      // 0xFF00
+        /* Interrupt Enable */                // 0xFFFF
+
+        std::array<Page, 0x100> page_table{}; // indexed by the high byte of the address
+        Port lcd_dma{};                       // the LCD's own handler of 0xFF46, which starts an OAM DMA here
+        std::function<void()> synchronizer{};
     };
 
     int make_address(std::uint8_t high, std::int8_t low);
@@ -1,15 +1,50 @@
 #ifndef IO_PORT_H
 #define IO_PORT_H
 
+#include <array>
 #include <cstdint>
+#include <utility>
 
 namespace gameboy::io {
-    class Port {
-    public:
-        virtual std::uint8_t read(int address) const = 0;
-        virtual void write(int address, std::uint8_t value) = 0;
-        virtual ~Port() = default;
+    /*
+        The handler of one register in the I/O page (0xFF00-0xFF7F). It's bound to the accessors of that
+        very register in the peripheral which owns it, so an access needs neither a virtual call nor a switch.
+    */
+    struct Port {
+        using Reader = std::uint8_t (*)(const void* owner);
+        using Writer = void (*)(void* owner, std::uint8_t value);
+
+        void* owner{};
+        Reader read{};
+        Writer write{};
+        bool is_scheduled{}; // the owner has to catch up with the CPU before the access
     };
+
+    using PortTable = std::array<Port, 0x80>; // indexed by the low byte of the address
+
+    constexpr int port_base{0xFF00};
+    constexpr std::uint8_t open_bus{0xFF}; // what a register without an owner reads as
+
+    template<typename T, int First, int... Offsets>
+    void bind_ports(PortTable& table, T& owner, bool is_scheduled, std::integer_sequence<int, Offsets...>)
+    {
+        ((table[First + Offsets - port_base] = Port{
+            &owner,
+            [](const void* p_owner) { return static_cast<const T*>(p_owner)->template read_port<First + Offsets>(); },
+            [](void* p_owner, std::uint8_t value) { static_cast<T*>(p_owner)->template write_port<First + Offsets>(value); },
+            is_scheduled
+        }), ...);
+    }
+
+    /*
+        Bind the registers from First to Last to T::read_port<Address>() and T::write_port<Address>(value).
+        The accessors are instantiated here, so this has to be called where they're defined.
+    */
+    template<int First, int Last, typename T>
+    void bind_ports(PortTable& table, T& owner, bool is_scheduled)
+    {
+        bind_ports<T, First>(table, owner, is_scheduled, std::make_integer_sequence<int, Last - First + 1>{});
+    }
 }
 
 #endif
\ No newline at end of file
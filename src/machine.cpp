@@ -0,0 +1,402 @@
+#include "machine.hpp"
+#include "io/bus.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace gameboy {
+    Machine::Machine(cartridge::Banking cartridge_space, ExecutionMode mode)
+        : execution_mode{mode}
+        , p_interrupt{std::make_unique<system::Interrupt>()}
+        , p_joypad{std::make_unique<system::Joypad>(*p_interrupt)}
+        , p_serial{std::make_unique<system::Serial>(*p_interrupt)}
+        , p_timer{std::make_unique<system::Timer>(*p_interrupt)}
+        , p_psg{std::make_unique<apu::Psg>()}
+        , p_lcd{std::make_unique<ppu::Lcd>(*p_interrupt)}
+        , p_vram{std::make_unique<ppu::Vram>(*p_lcd)}
+        , p_oam{std::make_unique<ppu::Oam>(*p_lcd)}
+        , p_apu{std::make_unique<apu::Core>()}
+    {
+        io::Bundle peripherals{
+            .cartridge_space{std::move(cartridge_space)},
+            .vram{*p_vram},
+            .oam{*p_oam},
+            .joypad{*p_joypad},
+            .serial{*p_serial},
+            .timer{*p_timer},
+            .interrupt{*p_interrupt},
+            .psg{*p_psg},
+            .lcd{*p_lcd}
+        };
+        auto p_address_bus{std::make_unique<io::Bus>(std::move(peripherals))};
+        p_bus = p_address_bus.get();
+        if (execution_mode == ExecutionMode::instruction) {
+            p_address_bus->set_synchronizer([this]() { synchronize(); });
+        }
+
+        p_cpu = std::make_unique<cpu::Core>(std::move(p_address_bus), *p_interrupt);
+        p_ppu = std::make_unique<ppu::Core>(*p_vram, *p_oam);
+        p_lcd->set_before_line_change([this]() { p_ppu->fall_back(*p_lcd); });
+    }
+
+    void Machine::preboot()
+    {
+        p_cpu->preboot();
+    }
+
+    void Machine::set_renderer(ppu::Renderer option)
+    {
+        p_ppu->set_renderer(option);
+    }
+
+    void Machine::set_drawing(bool enabled)
+    {
+        p_lcd->set_drawing(enabled);
+    }
+
+    void Machine::set_idle_loop_skipping(bool enabled)
+    {
+        p_cpu->set_loop_detection(enabled);
+        idle_loop_mark.reset();
+    }
+
+    void Machine::set_halt_skipping(bool enabled)
+    {
+        is_skipping_halt = enabled;
+    }
+
+    void Machine::step_frame()
+    {
+        run_cycles(cycles_per_frame - frame_cycle);
+    }
+
+    // Run for at least the given clock cycles and return the actual number of them.
+    int Machine::run_cycles(int cycles)
+    {
+        p_apu->clear_samples();
+        idle_loop_mark.reset(); // the joypad may have changed since the last run
+
+        auto elapsed{0};
+        while (elapsed < cycles) {
+            if (execution_mode == ExecutionMode::instruction) {
+                elapsed += 4 * run_until_event((cycles - elapsed + 3) / 4);
+            }
+            else if (auto skipped{skip_halt((cycles - elapsed + 3) / 4)}; skipped > 0) {
+                elapsed += 4 * skipped;
+            }
+            else {
+                p_timer->tick();
+                p_serial->tick();
+                p_cpu->tick();
+                tick_peripherals();
+
+                elapsed += 4;
+
+                if (auto head{p_cpu->take_idle_loop()}; head.has_value()) {
+                    elapsed += 4 * skip_idle_loop(*head, elapsed / 4, (cycles - elapsed + 3) / 4);
+                }
+            }
+        }
+
+        frame_cycle = (frame_cycle + elapsed) % cycles_per_frame;
+        p_bus->advance_cartridge(elapsed); // a cartridge clock lags by a run at most, well below its resolution of a second
+        return elapsed;
+    }
+
+    std::span<const std::uint8_t> Machine::get_frame() const
+    {
+        return p_lcd->get_frame();
+    }
+
+    std::uint64_t Machine::get_completed_frames() const
+    {
+        return p_lcd->get_completed_frames();
+    }
+
+    bool Machine::is_frame_unchanged(std::uint64_t completed) const
+    {
+        return p_lcd->is_frame_unchanged(completed);
+    }
+
+    std::span<const float> Machine::get_audio_samples() const
+    {
+        return p_apu->get_samples();
+    }
+
+    std::string_view Machine::get_serial_output() const
+    {
+        return p_serial->get_output();
+    }
+
+    const std::map<std::uint16_t, Machine::IdleLoopStats>& Machine::get_idle_loops() const
+    {
+        return idle_loops;
+    }
+
+    system::Joypad& Machine::get_joypad()
+    {
+        return *p_joypad;
+    }
+
+    std::size_t Machine::get_state_size() const
+    {
+        // Nothing is written into an empty buffer, but the required size is still counted.
+        state::Writer counter{{}};
+        counter.write(state::Header{});
+        save_components(counter);
+        return counter.get_size();
+    }
+
+    std::size_t Machine::save_state(std::span<std::uint8_t> buffer) const
+    {
+        auto size{get_state_size()};
+        if (buffer.size() < size) {
+            throw std::length_error{"The buffer is too small for the save state."};
+        }
+
+        state::Writer out{buffer.first(size)};
+        out.write(state::Header{.version{state::version}, .size{static_cast<std::uint32_t>(size)}});
+        save_components(out);
+        return size;
+    }
+
+    void Machine::load_state(std::span<const std::uint8_t> buffer)
+    {
+        state::Reader in{buffer};
+        auto header{in.read<state::Header>()};
+        if (header.magic != state::Header{}.magic) {
+            throw std::runtime_error{"Not a save state."};
+        }
+
+        if (header.version != state::version) {
+            throw std::runtime_error{"Unsupported save state version."};
+        }
+
+        if (header.size != get_state_size() || buffer.size() < header.size) {
+            throw std::runtime_error{"The save state belongs to a different machine."};
+        }
+
+        load_components(in);
+        idle_loop_mark.reset();
+    }
+
+    void Machine::tick_peripherals()
+    {
+        for (auto i{0}; i < 2; ++i) {
+            p_apu->tick(*p_psg);
+        }
+
+        for (auto i{0}; i < 4; ++i) {
+            p_ppu->tick(*p_lcd);
+        }
+
+        p_lcd->update();
+        p_psg->update();
+        p_psg->advance_sequencer(p_timer->get_divider());
+
+        for (auto i{0}; i < 4; ++i) {
+            p_psg->advance_waveform();
+        }
+    }
+
+    // Run the CPU until the next scheduled event or the given m-cycles at most.
+    int Machine::run_until_event(int cycles)
+    {
+        auto start{scheduler.now()};
+        scheduler.schedule(system::Scheduler::stop, cycles);
+        while (scheduler.now() < scheduler.next_deadline()) {
+            if (is_skipping_halt && p_cpu->is_halted() && !p_interrupt->has_pending()) {
+                // The components haven't run yet, so nothing can wake the CPU up before the deadline.
+                scheduler.advance(static_cast<int>(scheduler.next_deadline() - scheduler.now()));
+            }
+            else {
+                scheduler.advance(p_cpu->step());
+
+                if (auto head{p_cpu->take_idle_loop()}; head.has_value()) {
+                    skip_idle_loop(*head, scheduler.now(), static_cast<int>(scheduler.next_deadline() - scheduler.now()));
+                }
+            }
+        }
+
+        synchronize();
+        return static_cast<int>(scheduler.now() - start);
+    }
+
+    /*
+        While the CPU is halted, run the other components alone up to the m-cycle before the earliest
+        one which may request an interrupt, or the given m-cycles at most. Return the skipped m-cycles.
+    */
+    int Machine::skip_halt(int cycles)
+    {
+        if (!is_skipping_halt || !p_cpu->is_halted() || p_interrupt->has_pending()) {
+            return 0;
+        }
+
+        for (auto event : {p_timer->next_event(), p_serial->next_event(), p_lcd->next_event()}) {
+            if (event.has_value()) {
+                cycles = std::min(cycles, *event - 1);
+            }
+        }
+
+        if (cycles > 0) {
+            catch_up(cycles);
+        }
+
+        return std::max(cycles, 0);
+    }
+
+    /*
+        The CPU has come back to the head of an idle loop with the same registers as the last time. If nothing
+        the loop reads could have changed during that iteration, nothing will until the next event either, so
+        skip as many whole iterations as fit before it, or the given m-cycles at most. Return the skipped m-cycles.
+    */
+    int Machine::skip_idle_loop(std::uint16_t head, system::Scheduler::Timestamp now, int cycles)
+    {
+        auto until_event{std::numeric_limits<int>::max()};
+        if (execution_mode == ExecutionMode::instruction) {
+            // The deadline of the run is among the scheduled ones, which doesn't hurt.
+            until_event = static_cast<int>(scheduler.next_deadline() - now);
+        }
+        else {
+            for (auto event : {p_timer->next_event(), p_serial->next_event(), p_lcd->next_event()}) {
+                if (event.has_value()) {
+                    until_event = std::min(until_event, *event - 1);
+                }
+            }
+        }
+
+        auto previous{std::exchange(idle_loop_mark, IdleLoopMark{.head{head}, .time{now}, .until_event{until_event}})};
+        if (!previous.has_value() || previous->head != head) {
+            return 0;
+        }
+
+        auto period{static_cast<int>(now - previous->time)};
+        auto iterations{std::min(until_event, cycles) / period};
+        if (previous->until_event < period || iterations <= 0) {
+            return 0;
+        }
+
+        auto skipped{iterations * period};
+        if (execution_mode == ExecutionMode::instruction) {
+            scheduler.advance(skipped);
+        }
+        else {
+            catch_up(skipped);
+        }
+
+        // The CPU is at the head again, and the next event has come closer.
+        idle_loop_mark->time += skipped;
+        idle_loop_mark->until_event -= skipped;
+
+        auto& stats{idle_loops[head]};
+        ++stats.skips;
+        stats.iterations += static_cast<std::uint64_t>(iterations);
+        stats.cycles += static_cast<std::uint64_t>(skipped);
+
+        return skipped;
+    }
+
+    /*
+        Catch the components up with the CPU, then collect their next deadlines.
+        This happens whenever an event is due or the CPU accesses their registers.
+    */
+    void Machine::synchronize()
+    {
+        auto elapsed{static_cast<int>(scheduler.now() - synchronized_cycle)};
+        synchronized_cycle = scheduler.now();
+        catch_up(elapsed);
+
+        scheduler.schedule(system::Scheduler::timer, p_timer->next_event());
+        scheduler.schedule(system::Scheduler::serial, p_serial->next_event());
+        scheduler.schedule(system::Scheduler::lcd, p_lcd->next_event());
+    }
+
+    // Run the components other than the CPU for the given m-cycles.
+    void Machine::catch_up(int elapsed)
+    {
+        p_serial->advance(elapsed);
+
+        /*
+            The frame sequencer is clocked by the divider, so the timer has to keep pace with it. The channels
+            keep counting while the PSG is off, which only the m-cycle mode bothers with: it skips the halted
+            CPU through here, and the result has to stay the same as ticking every component.
+        */
+        if (p_psg->is_enabled() || execution_mode == ExecutionMode::m_cycle) {
+            for (auto i{0}; i < elapsed; ++i) {
+                p_timer->tick();
+
+                for (auto j{0}; j < 2; ++j) {
+                    p_apu->tick(*p_psg);
+                }
+
+                p_psg->advance_sequencer(p_timer->get_divider());
+
+                for (auto j{0}; j < 4; ++j) {
+                    p_psg->advance_waveform();
+                }
+            }
+        }
+        else {
+            p_timer->advance(elapsed);
+            if (elapsed > 0) {
+                p_apu->tick(*p_psg);
+            }
+        }
+
+        p_psg->update();
+
+        if (p_lcd->is_enabled()) {
+            for (auto i{0}; i < elapsed; ++i) {
+                for (auto j{0}; j < 4; ++j) {
+                    p_ppu->tick(*p_lcd);
+                }
+
+                p_lcd->update();
+            }
+        }
+        else if (elapsed > 0) {
+            // Both of them stay idle until the LCD is turned on.
+            p_ppu->tick(*p_lcd);
+            p_lcd->update();
+        }
+    }
+
+    void Machine::save_components(state::Writer& out) const
+    {
+        out.write(synchronized_cycle);
+        out.write(frame_cycle);
+        scheduler.save(out);
+
+        p_cpu->save(out);
+        p_interrupt->save(out);
+        p_joypad->save(out);
+        p_serial->save(out);
+        p_timer->save(out);
+        p_psg->save(out);
+        p_apu->save(out);
+        p_lcd->save(out);
+        p_vram->save(out);
+        p_oam->save(out);
+        p_ppu->save(out);
+    }
+
+    void Machine::load_components(state::Reader& in)
+    {
+        synchronized_cycle = in.read<system::Scheduler::Timestamp>();
+        frame_cycle = in.read<int>();
+        scheduler.load(in);
+
+        p_cpu->load(in);
+        p_interrupt->load(in);
+        p_joypad->load(in);
+        p_serial->load(in);
+        p_timer->load(in);
+        p_psg->load(in);
+        p_apu->load(in);
+        p_lcd->load(in);
+        p_vram->load(in);
+        p_oam->load(in);
+        p_ppu->load(in);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#ifndef MACHINE_H
+#define MACHINE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include "apu/core.hpp"
+#include "apu/psg.hpp"
+#include "cartridge/banking.hpp"
+#include "cpu/core.hpp"
+#include "ppu/core.hpp"
+#include "ppu/lcd.hpp"
+#include "ppu/oam.hpp"
+#include "ppu/vram.hpp"
+#include "state.hpp"
+#include "system/interrupt.hpp"
+#include "system/joypad.hpp"
+#include "system/scheduler.hpp"
+#include "system/serial.hpp"
+#include "system/timer.hpp"
+
+namespace gameboy {
+    /*
+        The whole emulated hardware without any dependency on a frontend. A frontend
+        drives it by frames or cycles, then consumes the frame and the audio samples.
+    */
+    class Machine {
+    public:
+        enum class ExecutionMode {
+            m_cycle,    // interleave the components every m-cycle
+            instruction // run the CPU until the next scheduled event, then catch the other components up
+        };
+
+        // How much an idle loop has been fast-forwarded, see cpu::LoopDetector.
+        struct IdleLoopStats {
+            std::uint64_t skips{};      // the times the loop has been found idle
+            std::uint64_t iterations{}; // the skipped iterations
+            std::uint64_t cycles{};     // the skipped m-cycles
+        };
+
+        explicit Machine(cartridge::Banking cartridge_space, ExecutionMode mode = ExecutionMode::m_cycle);
+        Machine(const Machine&) = delete;
+        Machine& operator=(const Machine&) = delete;
+
+        void preboot();
+        void set_renderer(ppu::Renderer option);
+        void set_drawing(bool enabled); // skipped frames keep LY, STAT and the interrupts but produce no pixels
+        void set_idle_loop_skipping(bool enabled); // on by default; the result is the same, but it can be ruled out
+        void set_halt_skipping(bool enabled);      // likewise, see skip_halt
+        void step_frame();
+        int run_cycles(int cycles);
+
+        std::span<const std::uint8_t> get_frame() const; // 160 * 144 pixels, see ppu::encode_pixel
+        std::uint64_t get_completed_frames() const;       // changes whenever a new frame is ready or a state is loaded
+        bool is_frame_unchanged(std::uint64_t completed) const; // for other threads, see ppu::Lcd::frames
+        std::span<const float> get_audio_samples() const; // interleaved stereo, produced by the last run
+        std::string_view get_serial_output() const;
+        const std::map<std::uint16_t, IdleLoopStats>& get_idle_loops() const; // by the address of the head
+        system::Joypad& get_joypad();
+
+        /*
+            A save state has the same size for the lifetime of a machine. Saving writes it into
+            the caller's buffer without allocating, and loading validates the header first.
+        */
+        std::size_t get_state_size() const;
+        std::size_t save_state(std::span<std::uint8_t> buffer) const;
+        void load_state(std::span<const std::uint8_t> buffer);
+
+        static constexpr int cycles_per_frame{70224};
+    private:
+        void tick_peripherals();
+        int run_until_event(int cycles);
+        int skip_halt(int cycles);
+        int skip_idle_loop(std::uint16_t head, system::Scheduler::Timestamp now, int cycles);
+        void synchronize();
+        void catch_up(int cycles);
+        void save_components(state::Writer& out) const;
+        void load_components(state::Reader& in);
+
+        ExecutionMode execution_mode;
+        bool is_skipping_halt{true};
+        system::Scheduler scheduler{};
+        system::Scheduler::Timestamp synchronized_cycle{};
+        int frame_cycle{};
+
+        // Where the CPU last came back to an idle loop, and how far the next event was from there.
+        struct IdleLoopMark {
+            std::uint16_t head;
+            system::Scheduler::Timestamp time;
+            int until_event;
+        };
+
+        std::optional<IdleLoopMark> idle_loop_mark{};
+        std::map<std::uint16_t, IdleLoopStats> idle_loops{};
+
+        std::unique_ptr<system::Interrupt> p_interrupt{};
+        std::unique_ptr<system::Joypad> p_joypad{};
+        std::unique_ptr<system::Serial> p_serial{};
+        std::unique_ptr<system::Timer> p_timer{};
+        std::unique_ptr<apu::Psg> p_psg{};
+        std::unique_ptr<ppu::Lcd> p_lcd{};
+        std::unique_ptr<ppu::Vram> p_vram{};
+        std::unique_ptr<ppu::Oam> p_oam{};
+        std::unique_ptr<apu::Core> p_apu{};
+        std::unique_ptr<cpu::Core> p_cpu{};
+        io::Bus* p_bus{}; // owned by the CPU
+        std::unique_ptr<ppu::Core> p_ppu{};
+    };
+}
+
+#endif
\ No newline at end of file
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <string>
+#include <string_view>
 #include "SDL.h"
 #include "emulator.hpp"
 
@@ -5,7 +8,34 @@ int main(int argc, char *argv[])
 {
     using gameboy::Emulator;
 
-    Emulator emulator{};
+    auto mode{Emulator::ExecutionMode::m_cycle};
+    auto rewind_budget{Emulator::default_rewind_budget};
+    auto renderer{gameboy::ppu::Renderer::fifo};
+    auto speed{1.0};
+    auto frame_skip{0};
+    for (auto i{1}; i < argc; ++i) {
+        std::string_view option{argv[i]};
+        if (option == "--fast") {
+            mode = Emulator::ExecutionMode::instruction;
+        }
+        else if (option == "--scanline") {
+            renderer = gameboy::ppu::Renderer::scanline;
+        }
+        else if (option == "--speed" && i + 1 < argc) {
+            speed = std::stod(argv[++i]); // 0 for unbounded
+        }
+        else if (option == "--uncapped") {
+            speed = 0.0;
+        }
+        else if (option == "--frame-skip" && i + 1 < argc) {
+            frame_skip = std::max(std::stoi(argv[++i]), 0);
+        }
+        else if (option == "--rewind-mb" && i + 1 < argc) {
+            rewind_budget = std::stoul(argv[++i]) << 20;
+        }
+    }
+
+    Emulator emulator{mode, rewind_budget, renderer, speed, frame_skip};
     emulator.run();
 
     return 0;
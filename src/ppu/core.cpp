@@ -1,5 +1,7 @@
 #include "core.hpp"
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 
 namespace gameboy::ppu {
     bool check_window(const Lcd& screen, Position current_position)
@@ -16,6 +18,58 @@ namespace gameboy::ppu {
         return screen.is_sprite_displayed() && sprite_x <= shifter_x + 8;
     }
 
+    void SpriteBuffer::insert(const Sprite& sprite)
+    {
+        if (count == capacity) {
+            return;
+        }
+
+        if (head > 0) {
+            std::move(sprites.begin() + head, sprites.begin() + head + count, sprites.begin());
+            head = 0;
+        }
+
+        // after the sprites with the same X, like std::multimap::insert
+        auto position{std::upper_bound(sprites.begin(), sprites.begin() + count, sprite, [](const Sprite& a, const Sprite& b) {
+            return a.pos.x < b.pos.x;
+        })};
+        std::move_backward(position, sprites.begin() + count, sprites.begin() + count + 1);
+        *position = sprite;
+        ++count;
+    }
+
+    void SpriteBuffer::pop_front()
+    {
+        ++head;
+        --count;
+    }
+
+    const Sprite& SpriteBuffer::front() const
+    {
+        return sprites[head];
+    }
+
+    const Sprite& SpriteBuffer::operator[](int index) const
+    {
+        return sprites[head + index];
+    }
+
+    void SpriteBuffer::clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+    bool SpriteBuffer::empty() const
+    {
+        return count == 0;
+    }
+
+    int SpriteBuffer::size() const
+    {
+        return count;
+    }
+
     Core::Core(std::reference_wrapper<Vram> vram_ref, std::reference_wrapper<Oam> oam_ref)
         : vram{vram_ref}, oam{oam_ref}
     {
@@ -26,12 +80,175 @@ namespace gameboy::ppu {
         operation(this, screen);
     }
 
+    void Core::set_renderer(Renderer option)
+    {
+        renderer = option;
+        fallback_frames = 0;
+    }
+
+    /*
+        A write in the middle of a line is meant for a raster effect, which only the FIFO can reproduce.
+        Nothing the line depends on has changed yet, so the FIFO is replayed up to the current dot,
+        which draws the same pixels again, and takes over from there. It also keeps drawing the rest
+        of this frame and the whole next one, since such effects tend to repeat.
+    */
+    void Core::fall_back(Lcd& screen)
+    {
+        constexpr int oam_search_duration{80};
+
+        if (renderer == Renderer::scanline) {
+            fallback_frames = 2;
+        }
+
+        if (is_fifo_line || screen.is_frame_skipped()) {
+            return;
+        }
+
+        auto current_scanline{screen.get_y_coordinate()};
+        if (scanline_x <= oam_search_duration) {
+            for (auto x{0}; x < scanline_x; ++x) {
+                search_sprite(current_scanline, x);
+            }
+        }
+        else {
+            // The sprites have been searched already, but the window is entered once more.
+            is_window_active = false;
+        }
+
+        for (auto x{oam_search_duration}; x < scanline_x && shifter.counter_x < Lcd::pixels_per_scanline; ++x) {
+            transfer_pixel(screen, current_scanline);
+        }
+
+        is_fifo_line = true;
+    }
+
+    /*
+        The queues are saved into slots of a fixed capacity, so that the state keeps the same layout.
+        A background fetch never pushes more than 8 pixels ahead of the shifter, a sprite fetch
+        tops the sprite queue up to 8 pixels, and at most 10 sprites are found per scanline.
+    */
+    constexpr int background_queue_capacity{16};
+    constexpr int sprite_queue_capacity{8};
+    constexpr int sprite_buffer_capacity{SpriteBuffer::capacity};
+
+    void write_sprite(state::Writer& out, const Sprite& sprite)
+    {
+        out.write(sprite.pos.x);
+        out.write(sprite.pos.y);
+        out.write(sprite.tile_id);
+        out.write(static_cast<std::uint8_t>(sprite.attribute.to_ulong()));
+    }
+
+    Sprite read_sprite(state::Reader& in)
+    {
+        Sprite sprite{};
+        sprite.pos.x = in.read<int>();
+        sprite.pos.y = in.read<int>();
+        sprite.tile_id = in.read<int>();
+        sprite.attribute = in.read<std::uint8_t>();
+        return sprite;
+    }
+
+    int read_count(state::Reader& in, int capacity)
+    {
+        auto count{in.read<int>()};
+        if (count < 0 || count > capacity) {
+            throw std::out_of_range{"Invalid queue size."};
+        }
+
+        return count;
+    }
+
+    void Core::save(state::Writer& out) const
+    {
+        if (background_queue.size() > background_queue_capacity || sprite_queue.size() > sprite_queue_capacity) {
+            throw std::length_error{"The pixel queues exceed the capacity of a save state."};
+        }
+
+        out.write(*operation.target<void (Core::*)(Lcd&)>() == &Core::work);
+        out.write(cycle);
+        out.write(scanline_x);
+        out.write(is_window_active);
+        out.write(is_fifo_line);
+        out.write(transfer_end);
+        out.write(fallback_frames);
+
+        out.write(fetcher.counter_x);
+        out.write(fetcher.window_line_counter);
+        out.write(fetcher.address);
+        out.write(fetcher.tile_id);
+        out.write(shifter.counter_x);
+
+        out.write(background_queue.size());
+        for (auto i{0}; i < background_queue_capacity; ++i) {
+            out.write(i < background_queue.size() ? background_queue[i].color_id : 0);
+        }
+
+        out.write(sprite_queue.size());
+        for (auto i{0}; i < sprite_queue_capacity; ++i) {
+            auto pixel{i < sprite_queue.size() ? sprite_queue[i] : SpritePixel{}};
+            out.write(pixel.color_id);
+            out.write(pixel.palette_id);
+            out.write(pixel.priority);
+        }
+
+        out.write(sprite_buffer.size());
+        for (auto i{0}; i < sprite_buffer_capacity; ++i) {
+            write_sprite(out, i < sprite_buffer.size() ? sprite_buffer[i] : Sprite{});
+        }
+    }
+
+    void Core::load(state::Reader& in)
+    {
+        operation = in.read<bool>() ? &Core::work : &Core::idle;
+        cycle = in.read<int>();
+        scanline_x = in.read<int>();
+        is_window_active = in.read<bool>();
+        is_fifo_line = in.read<bool>();
+        transfer_end = in.read<int>();
+        fallback_frames = in.read<int>();
+
+        fetcher.counter_x = in.read<int>();
+        fetcher.window_line_counter = in.read<int>();
+        fetcher.address = in.read<int>();
+        fetcher.tile_id = in.read<int>();
+        shifter.counter_x = in.read<int>();
+
+        background_queue.clear();
+        auto background_count{read_count(in, background_queue_capacity)};
+        for (auto i{0}; i < background_queue_capacity; ++i) {
+            Pixel pixel{in.read<int>()};
+            if (i < background_count) {
+                background_queue.push_back(pixel);
+            }
+        }
+
+        sprite_queue.clear();
+        auto sprite_count{read_count(in, sprite_queue_capacity)};
+        for (auto i{0}; i < sprite_queue_capacity; ++i) {
+            SpritePixel pixel{};
+            pixel.color_id = in.read<int>();
+            pixel.palette_id = in.read<std::uint8_t>();
+            pixel.priority = in.read<std::uint8_t>();
+            if (i < sprite_count) {
+                sprite_queue.push_back(pixel);
+            }
+        }
+
+        sprite_buffer.clear();
+        auto buffer_count{read_count(in, sprite_buffer_capacity)};
+        for (auto i{0}; i < sprite_buffer_capacity; ++i) {
+            auto sprite{read_sprite(in)};
+            if (i < buffer_count) {
+                sprite_buffer.insert(sprite);
+            }
+        }
+    }
+
     void Core::fetch_background(const Lcd& screen, int current_scanline, bool is_window_active)
     {
-        static int address{};
-        static int tile_id{};
-        static std::bitset<8> low_byte{};
-        static std::bitset<8> high_byte{};
+        auto& address{fetcher.address};
+        auto& tile_id{fetcher.tile_id};
 
         // pixel transfer: first 6 cycles are discarded
         if (fetcher.counter_x >= 6) {
@@ -59,11 +276,6 @@ namespace gameboy::ppu {
                         auto scroll_y{screen.get_scroll_y()};
                         address = TileDataIndex{}(tile_id, screen.data_region_selection(), current_scanline, scroll_y);
                     }
-
-                    low_byte = vram.get().read(address);
-                    break;
-                case 4:
-                    high_byte = vram.get().read(address + 1);
                     break;
                 case 6: {
                         auto discarded_pixels{0};
@@ -75,9 +287,10 @@ namespace gameboy::ppu {
                             discarded_pixels = (x < 8) ? (screen.get_scroll_x() % 8) : 0;
                         }
 
-                        for (auto i{7 - discarded_pixels}; i >= 0; --i) {
-                            auto color_id{(high_byte[i] << 1) | low_byte[i]};
-                            background_queue.push({color_id});
+                        // Both bytes of the row have been fetched by now, so it comes from the decoded tiles.
+                        auto row{vram.get().get_tile_row(address)};
+                        for (auto i{discarded_pixels}; i < 8; ++i) {
+                            background_queue.push_back({row[i]});
                         }
                     }
                     break;
@@ -91,25 +304,21 @@ namespace gameboy::ppu {
 
     void Core::fetch_sprite(const Lcd& screen, int current_scanline)
     {
-        auto sprite{sprite_buffer.cbegin()->second};
-        auto address{TileDataIndex{}(sprite.tile_id, 1, current_scanline - sprite.pos.y % 8, 0, sprite.attribute.test(Sprite::y_flip))};
-        std::bitset<8> low_byte = vram.get().read(address);
-        std::bitset<8> high_byte = vram.get().read(address + 1);
+        auto sprite{sprite_buffer.front()};
+        auto address{TileDataIndex{}(sprite.tile_id, 1, current_scanline + 16 - sprite.pos.y, 0, sprite.attribute.test(Sprite::y_flip))};
+        auto row{vram.get().get_tile_row(address)};
 
-        auto discarded_pixels{std::ssize(sprite_queue) + (sprite.pos.x < 8 ? 8 - sprite.pos.x : 0)};
+        auto discarded_pixels{sprite_queue.size() + (sprite.pos.x < 8 ? 8 - sprite.pos.x : 0)};
 
-        for (auto i{7 - discarded_pixels}; i >= 0; --i) {
-            auto bit_pos{sprite.attribute.test(Sprite::x_flip) ? (7 - i) : i};
-            auto color_id{(high_byte[bit_pos] << 1) | low_byte[bit_pos]};
-
-            sprite_queue.push(SpritePixel{
-                color_id,
+        for (auto i{discarded_pixels}; i < 8; ++i) {
+            sprite_queue.push_back(SpritePixel{
+                row[sprite.attribute.test(Sprite::x_flip) ? (7 - i) : i],
                 sprite.attribute.test(Sprite::palette_number),
                 sprite.attribute.test(Sprite::priority)
             });
         }
 
-        sprite_buffer.erase(sprite_buffer.cbegin());
+        sprite_buffer.pop_front();
     }
 
     void Core::search_sprite(int current_scanline, int scanline_x)
@@ -126,33 +335,181 @@ namespace gameboy::ppu {
             };
 
             bool y_condition{(current_scanline + 16) >= sprite.pos.y && (current_scanline + 16) < (sprite.pos.y + 8)};
-            if (y_condition && sprite_buffer.size() < 10) {
-                sprite_buffer.insert({sprite.pos.x, sprite});
+            if (y_condition) {
+                sprite_buffer.insert(sprite);
+            }
+        }
+    }
+
+    /*
+        Draw the whole scanline at once when the pixel transfer begins. The pixel FIFO is replayed
+        dot by dot with local queues, so that the window and sprite timing (and the quirks of
+        fetch_background and fetch_sprite) give the very same pixels, but the registers are read
+        only once. This holds as long as they are not written until the line is finished, see fall_back.
+    */
+    void Core::render_scanline(Lcd& screen, int current_scanline)
+    {
+        constexpr int oam_search_duration{80};
+        constexpr int transfer_duration{456 - oam_search_duration};
+
+        // The sprite buffer is filled the same way, but all at once.
+        for (auto x{0}; x < oam_search_duration; ++x) {
+            search_sprite(current_scanline, x);
+        }
+
+        // The sprite buffer is left as it is, in case the FIFO has to take over the line.
+        auto sprites{sprite_buffer};
+        PixelFifo<Pixel> background_pixels{};
+        PixelFifo<SpritePixel> sprite_pixels{};
+
+        auto fetcher_x{0};
+        auto shifter_x{0};
+        auto window_active{false};
+        auto& ram{vram.get()};
+
+        // The registers can't change until the line is done, so they are read only once.
+        auto is_background_displayed{screen.is_background_displayed()};
+        auto is_sprite_displayed{screen.is_sprite_displayed()};
+        auto window_position{screen.get_window_position()};
+        auto is_window_reached{screen.is_window_displayed() && window_position.y == current_scanline};
+        auto data_region{screen.data_region_selection()};
+        auto scroll_y{screen.get_scroll_y()};
+        auto scroll_x{screen.get_scroll_x()};
+
+        // The line is composed of indices into the palettes, which are turned into pixels at the end.
+        std::array<std::uint8_t, Lcd::pixels_per_scanline> palette_indices{};
+
+        auto dot{0};
+        for (; dot < transfer_duration && shifter_x < Lcd::pixels_per_scanline; ++dot) {
+            if (!window_active && is_window_reached && window_position.x <= shifter_x + 7) {
+                window_active = true;
+                fetcher_x = 0;
+            }
+
+            if (!sprites.empty() && is_sprite_displayed && sprites.front().pos.x <= shifter_x + 8) {
+                auto sprite{sprites.front()};
+                sprites.pop_front();
+                auto address{TileDataIndex{}(sprite.tile_id, 1, current_scanline + 16 - sprite.pos.y, 0, sprite.attribute.test(Sprite::y_flip))};
+                auto row{ram.get_tile_row(address)};
+
+                auto discarded_pixels{sprite_pixels.size() + (sprite.pos.x < 8 ? 8 - sprite.pos.x : 0)};
+                for (auto i{discarded_pixels}; i < 8; ++i) {
+                    sprite_pixels.push_back(SpritePixel{
+                        row[sprite.attribute.test(Sprite::x_flip) ? (7 - i) : i],
+                        sprite.attribute.test(Sprite::palette_number),
+                        sprite.attribute.test(Sprite::priority)
+                    });
+                }
+            }
+
+            // The whole tile is fetched on the dot fetch_background would push it.
+            if (fetcher_x >= 6 && (fetcher_x - 6) % 8 == 6) {
+                auto x{fetcher_x - 12}; // where fetch_background would have read the tile id
+                auto discarded_pixels{0};
+                auto address{0};
+                if (window_active) {
+                    auto tile_id{ram.read(TileIdIndex{}(screen.window_map_selection(), fetcher.window_line_counter, 0, x, 0))};
+                    address = TileDataIndex{}(tile_id, data_region, fetcher.window_line_counter, 0);
+                    discarded_pixels = (x < 8 && window_position.x < 7) ? (7 - window_position.x) : 0;
+                }
+                else {
+                    auto tile_id{ram.read(TileIdIndex{}(screen.background_map_selection(), current_scanline, scroll_y, x, scroll_x))};
+                    address = TileDataIndex{}(tile_id, data_region, current_scanline, scroll_y);
+                    discarded_pixels = (x < 8) ? (scroll_x % 8) : 0;
+                }
+
+                auto row{ram.get_tile_row(address)};
+                for (auto i{discarded_pixels}; i < 8; ++i) {
+                    background_pixels.push_back({row[i]});
+                }
+            }
+
+            ++fetcher_x;
+
+            if (!background_pixels.empty()) {
+                auto color_id{is_background_displayed ? background_pixels.front().color_id : 0};
+                background_pixels.pop_front();
+
+                auto palette_index{color_id};
+
+                if (!sprite_pixels.empty()) {
+                    const auto& sprite_pixel{sprite_pixels.front()};
+                    if (sprite_pixel.color_id > 0 && (sprite_pixel.priority == 0 || (sprite_pixel.priority == 1 && color_id == 0))) {
+                        palette_index = 4 + sprite_pixel.palette_id * 4 + sprite_pixel.color_id;
+                    }
+
+                    sprite_pixels.pop_front();
+                }
+
+                palette_indices[shifter_x++] = static_cast<std::uint8_t>(palette_index);
+            }
+        }
+
+        std::array<std::uint8_t, Lcd::pixels_per_scanline * bytes_per_pixel> pixels{};
+        apply_palettes(std::span{palette_indices}.first(shifter_x), screen.get_palette_colors(), pixels);
+        screen.draw(0, std::span{pixels}.first(shifter_x * bytes_per_pixel));
+
+        // The window line counter is advanced at the end of the line as usual.
+        is_window_active = window_active;
+        transfer_end = oam_search_duration + dot;
+    }
+
+    // One dot of the pixel transfer on the FIFO
+    void Core::transfer_pixel(Lcd& screen, int current_scanline)
+    {
+        if (!is_window_active && check_window(screen, {shifter.counter_x, current_scanline})) {
+            is_window_active = true;
+            fetcher.counter_x = 0;
+        }
+
+        if (!sprite_buffer.empty() && check_sprite(screen, shifter.counter_x, sprite_buffer.front().pos.x)) {
+            fetch_sprite(screen, current_scanline);
+        }
+
+        fetch_background(screen, current_scanline, is_window_active);
+
+        if (!background_queue.empty()) {
+            auto color_id{0};
+            if (screen.is_background_displayed()) {
+                color_id = background_queue.front().color_id;
+            }
+
+            background_queue.pop_front();
+
+            auto color{screen.get_background_color(color_id)};
+
+            if (!sprite_queue.empty()) {
+                const auto& sprite_pixel{sprite_queue.front()};
+                if (sprite_pixel.color_id > 0 && (sprite_pixel.priority == 0 || (sprite_pixel.priority == 1 && color_id == 0))) {
+                    color = screen.get_object_color(sprite_pixel.palette_id, sprite_pixel.color_id);
+                }
+
+                sprite_queue.pop_front();
             }
+
+            screen.draw(shifter.counter_x, color);
+            ++shifter.counter_x;
         }
     }
 
     void Core::idle(Lcd& screen)
     {
         if (screen.is_enabled()) {
-            operation = work;
+            operation = &Core::work;
             operation(this, screen);
         }
     }
 
     void Core::work(Lcd& screen)
     {
-        static int cycle{0};
-        static int scanline_x{0};
-        static bool is_window_active{false};
-
         if (!screen.is_enabled()) {
-            operation = idle;
+            operation = &Core::idle;
             cycle = 0;
             scanline_x = 0;
             is_window_active = false;
             fetcher = {};
             shifter = {};
+            screen.set_drawing_mode(Mode::h_blank);
             return;
         }
 
@@ -184,11 +541,37 @@ namespace gameboy::ppu {
 
         auto current_scanline{screen.get_y_coordinate()};
 
+        if (scanline_x == 0) {
+            is_fifo_line = renderer == Renderer::fifo || fallback_frames > 0;
+            if (current_scanline >= Lcd::scanlines_per_frame) {
+                screen.set_drawing_mode(Mode::v_blank);
+            }
+            else {
+                screen.set_drawing_mode(screen.is_frame_skipped() ? Mode::h_blank : Mode::oam_search);
+            }
+        }
+
         if (current_scanline >= Lcd::scanlines_per_frame) {
             // v-blank
             if (current_scanline == Lcd::scanlines_per_frame && scanline_x == 0) {
                 fetcher.window_line_counter = 0;
                 sprite_buffer.clear();
+
+                if (fallback_frames > 0) {
+                    --fallback_frames;
+                }
+            }
+        }
+        else if (screen.is_frame_skipped()) {
+            // The LCD keeps counting the lines and raising the interrupts on its own.
+        }
+        else if (!is_fifo_line) {
+            if (scanline_x == oam_search_duration) {
+                render_scanline(screen, current_scanline);
+                screen.set_drawing_mode(Mode::pixel_transfer);
+            }
+            else if (scanline_x == transfer_end - 1) {
+                screen.set_drawing_mode(Mode::h_blank); // where the FIFO would have drawn the last pixel
             }
         }
         else if (scanline_x < oam_search_duration) {
@@ -196,38 +579,13 @@ namespace gameboy::ppu {
             search_sprite(current_scanline, scanline_x);
         }
         else if (shifter.counter_x < Lcd::pixels_per_scanline) {
-            if (!is_window_active && check_window(screen, {shifter.counter_x, current_scanline})) {
-                is_window_active = true;
-                fetcher.counter_x = 0;
+            if (scanline_x == oam_search_duration) {
+                screen.set_drawing_mode(Mode::pixel_transfer);
             }
 
-            if (!sprite_buffer.empty() && check_sprite(screen, shifter.counter_x, sprite_buffer.cbegin()->first)) {
-                fetch_sprite(screen, current_scanline);
-            }
-
-            fetch_background(screen, current_scanline, is_window_active);
-
-            if (!background_queue.empty()) {
-                auto color_id{0};
-                if (screen.is_background_displayed()) {
-                    color_id = background_queue.front().color_id;
-                }
-
-                background_queue.pop();
-
-                auto color{screen.get_background_color(color_id)};
-
-                if (!sprite_queue.empty()) {
-                    const auto& sprite_pixel{sprite_queue.front()};
-                    if (sprite_pixel.color_id > 0 && (sprite_pixel.priority == 0 || (sprite_pixel.priority == 1 && color_id == 0))) {
-                        color = screen.get_object_color(sprite_pixel.palette_id, sprite_pixel.color_id);
-                    }
-
-                    sprite_queue.pop();
-                }
-
-                screen.append(color);
-                ++shifter.counter_x;
+            transfer_pixel(screen, current_scanline);
+            if (shifter.counter_x == Lcd::pixels_per_scanline) {
+                screen.set_drawing_mode(Mode::h_blank);
             }
         }
 
@@ -241,8 +599,8 @@ namespace gameboy::ppu {
             scanline_x = 0;
             fetcher.counter_x = 0;
             shifter.counter_x = 0;
-            background_queue = {};
-            sprite_queue = {};
+            background_queue.clear();
+            sprite_queue.clear();
             sprite_buffer.clear();
         }
 
@@ -1,13 +1,13 @@
 #ifndef PPU_CORE_H
 #define PPU_CORE_H
 
+#include <array>
 #include <bitset>
 #include <cstdint>
 #include <functional>
-#include <map>
-#include <queue>
 #include "lcd.hpp"
 #include "oam.hpp"
+#include "state.hpp"
 #include "tile.hpp"
 #include "vram.hpp"
 
@@ -42,31 +42,119 @@ namespace gameboy::ppu {
     struct Fetcher {
         int counter_x;
         int window_line_counter;
+        int address;
+        int tile_id;
     };
 
     struct Shifter {
         int counter_x;
     };
 
+    // A queue of pixels stored inline. Neither the fetcher nor the sprite fetch ever fills it up.
+    template<typename T, int Capacity = 16>
+    class PixelFifo {
+    public:
+        static_assert((Capacity & (Capacity - 1)) == 0, "The capacity must be a power of 2.");
+
+        void push_back(const T& pixel)
+        {
+            slots[(head + count++) & (Capacity - 1)] = pixel;
+        }
+
+        void pop_front()
+        {
+            head = (head + 1) & (Capacity - 1);
+            --count;
+        }
+
+        const T& front() const
+        {
+            return slots[head];
+        }
+
+        const T& operator[](int index) const
+        {
+            return slots[(head + index) & (Capacity - 1)];
+        }
+
+        void clear()
+        {
+            head = 0;
+            count = 0;
+        }
+
+        bool empty() const
+        {
+            return count == 0;
+        }
+
+        int size() const
+        {
+            return count;
+        }
+    private:
+        std::array<T, Capacity> slots{};
+        int head{};
+        int count{};
+    };
+
+    // The sprites found on a scanline, ordered by X and then by their order in OAM.
+    class SpriteBuffer {
+    public:
+        static constexpr int capacity{10};
+
+        void insert(const Sprite& sprite); // ignored when full
+        void pop_front();
+        const Sprite& front() const;
+        const Sprite& operator[](int index) const;
+        void clear();
+        bool empty() const;
+        int size() const;
+    private:
+        std::array<Sprite, capacity> sprites{};
+        int head{};
+        int count{};
+    };
+
+    enum class Renderer {
+        fifo,    // run the pixel FIFO one dot at a time
+        scanline // draw a whole line at the start of the pixel transfer, or fall back to fifo for mid-line writes
+    };
+
     class Core {
     public:
         explicit Core(std::reference_wrapper<Vram> unique_vram, std::reference_wrapper<Oam> unique_oam);
         void tick(Lcd& screen);
+        void set_renderer(Renderer option);
+        void fall_back(Lcd& screen); // to the FIFO for the rest of the line, before what it reads changes
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
     private:
         void fetch_background(const Lcd& screen, int current_scanline, bool is_window_active);
         void fetch_sprite(const Lcd& screen, int current_scanline);
         void search_sprite(int current_scanline, int scanline_x);
+        void render_scanline(Lcd& screen, int current_scanline);
+        void transfer_pixel(Lcd& screen, int current_scanline);
         void idle(Lcd& screen);
         void work(Lcd& screen);
 
         std::function<void(Core*, Lcd&)> operation{&Core::idle};
 
+        Renderer renderer{Renderer::fifo};
+        bool is_fifo_line{true};  // the path taken by the current scanline
+        int transfer_end{};       // the dot where the FIFO would finish the line drawn at once
+        int fallback_frames{};    // frames left to run on the FIFO after a mid-line write
+
+        int cycle{};
+        int scanline_x{};
+        bool is_window_active{false};
+
         Fetcher fetcher{};
         Shifter shifter{};
 
-        std::queue<Pixel> background_queue{};
-        std::queue<SpritePixel> sprite_queue{};
-        std::multimap<int, Sprite> sprite_buffer{};
+        PixelFifo<Pixel> background_queue{};
+        PixelFifo<SpritePixel> sprite_queue{};
+        SpriteBuffer sprite_buffer{};
 
         std::reference_wrapper<Vram> vram;
         std::reference_wrapper<Oam> oam;
@@ -1,6 +1,7 @@
 #include "lcd.hpp"
+#include <algorithm>
 #include <array>
-#include <stdexcept>
+#include <bit>
 #include <utility>
 
 namespace gameboy::ppu {
@@ -24,9 +25,13 @@ namespace gameboy::ppu {
         return ((status >> 6) & 1U) == 1U;
     }
 
+    constexpr int frame_size{Lcd::pixels_per_scanline * Lcd::scanlines_per_frame * bytes_per_pixel};
+
     Lcd::Lcd(std::reference_wrapper<system::Interrupt> interrupt_ref) : interrupt{std::move(interrupt_ref)}
     {
-        frame_buffer.reserve(pixels_per_scanline * scanlines_per_frame * 4);
+        for (auto& frame : frames) {
+            frame.resize(frame_size, 0xFF);
+        }
     }
 
     bool Lcd::is_background_displayed() const
@@ -110,11 +115,10 @@ namespace gameboy::ppu {
         return {regs.window_x, regs.window_y};
     }
 
-    void Lcd::update(SDL_Renderer& renderer, SDL_Texture& texture)
+    void Lcd::update()
     {
         static constexpr int x_modulus{114};
         static constexpr int ly_modulus{154};
-        static int counter_x{0};
 
         if (!is_enabled()) {
             regs.status &= 0b1111'1100;
@@ -134,8 +138,14 @@ namespace gameboy::ppu {
         if (regs.ly == scanlines_per_frame && counter_x == 0) {
             regs.status = (regs.status & 0b1111'1100) + 1;
             interrupt(system::Interrupt::vblank);
-            ui::render<Lcd::pixels_per_scanline, Lcd::scanlines_per_frame>(renderer, texture, frame_buffer);
-            frame_buffer.clear();
+
+            if (!is_skipping_frame) {
+                front.store(back, std::memory_order_release);
+                back = 1 - back;
+                ++completed_frames;
+            }
+
+            is_skipping_frame = !is_drawing;
         }
 
         // mode 2
@@ -156,92 +166,215 @@ namespace gameboy::ppu {
         }
     }
 
-    void Lcd::append(std::uint8_t color)
-    {
-        frame_buffer.push_back(0xFF);  // A
-        frame_buffer.push_back(color); // B
-        frame_buffer.push_back(color); // G
-        frame_buffer.push_back(color); // R
-    }
-
-    std::uint8_t Lcd::read(int address) const
-    {
-        switch (address) {
-            case 0xFF40:
-                return regs.control;
-            case 0xFF41:
-                return regs.status;
-            case 0xFF42:
-                return regs.scroll_y;
-            case 0xFF43:
-                return regs.scroll_x;
-            case 0xFF44:
-                return regs.ly;
-            case 0xFF45:
-                return regs.ly_compare;
-            case 0xFF46:
-                return regs.dma_transfer;
-            case 0xFF47:
-                return regs.background_palette;
-            case 0xFF48:
-                return regs.object_palette_0;
-            case 0xFF49:
-                return regs.object_palette_1;
-            case 0xFF4A:
-                return regs.window_y;
-            case 0xFF4B:
-                return regs.window_x;
-            default:
-                throw std::out_of_range{"Invalid address."};
-        }
-    }
-
-    void Lcd::write(int address, std::uint8_t value)
-    {
-        switch (address) {
-            case 0xFF40:
-                regs.control = value;
-                return;
-            case 0xFF41:
-                regs.status = value | 0b1000'0000;
-                return;
-            case 0xFF42:
-                regs.scroll_y = value;
-                return;
-            case 0xFF43:
-                regs.scroll_x = value;
-                return;
-            case 0xFF44:
-                return; // read-only
-            case 0xFF45:
-                regs.ly_compare = value;
-                return;
-            case 0xFF46:
-                regs.dma_transfer = value;
-                return;
-            case 0xFF47:
-                regs.background_palette = value;
-                return;
-            case 0xFF48:
-                regs.object_palette_0 = value;
-                return;
-            case 0xFF49:
-                regs.object_palette_1 = value;
-                return;
-            case 0xFF4A:
-                regs.window_y = value;
-                return;
-            case 0xFF4B:
-                regs.window_x = value;
-                return;
-            default:
-                throw std::out_of_range{"Invalid address."};
+    std::optional<int> Lcd::next_event() const
+    {
+        if (!is_enabled()) {
+            return std::nullopt;
         }
+
+        // The mode may change at the 0th, 20th and 73rd m-cycle of a scanline, and LY at the last one.
+        constexpr std::array<int, 4> transitions{0, 20, 20 + 53, 113};
+        auto next{*std::lower_bound(transitions.cbegin(), transitions.cend(), counter_x)};
+
+        return next - counter_x + 1;
+    }
+
+    void Lcd::draw(int x, std::uint8_t color)
+    {
+        auto pixel{encode_pixel(color)};
+        auto offset{(regs.ly * pixels_per_scanline + x) * bytes_per_pixel};
+        std::copy(pixel.cbegin(), pixel.cend(), frames[back].begin() + offset);
+    }
+
+    void Lcd::draw(int x, std::span<const std::uint8_t> pixels)
+    {
+        auto offset{(regs.ly * pixels_per_scanline + x) * bytes_per_pixel};
+        std::copy(pixels.begin(), pixels.end(), frames[back].begin() + offset);
+    }
+
+    PaletteColors Lcd::get_palette_colors() const
+    {
+        auto to_pixel = [](std::uint8_t color) {
+            return std::bit_cast<std::uint32_t>(encode_pixel(color));
+        };
+
+        PaletteColors colors{};
+        for (auto index{0}; index < 4; ++index) {
+            colors[index] = to_pixel(get_background_color(index));
+            colors[4 + index] = to_pixel(get_object_color(0, index));
+            colors[8 + index] = to_pixel(get_object_color(1, index));
+        }
+
+        return colors;
+    }
+
+    std::span<const std::uint8_t> Lcd::get_frame() const
+    {
+        return frames[front.load(std::memory_order_acquire)];
+    }
+
+    std::uint64_t Lcd::get_completed_frames() const
+    {
+        return completed_frames;
+    }
+
+    bool Lcd::is_frame_unchanged(std::uint64_t completed) const
+    {
+        // The pixels read before can't be reordered after the count read here.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return completed_frames.load(std::memory_order_relaxed) == completed;
+    }
+
+    void Lcd::set_drawing(bool enabled)
+    {
+        is_drawing = enabled;
+    }
+
+    bool Lcd::is_frame_skipped() const
+    {
+        return is_skipping_frame;
+    }
+
+    void Lcd::save(state::Writer& out) const
+    {
+        out.write(regs);
+        out.write(counter_x);
+        out.write(stat_signal);
+        out.write(drawing_mode);
+        out.write(is_skipping_frame);
+        // The rest of the back frame is drawn again before it's shown, so it's left out for the sake of rewinding.
+        auto drawn_size{regs.ly < scanlines_per_frame ? (regs.ly + 1) * pixels_per_scanline * bytes_per_pixel : 0};
+        out.write_bytes(std::span{frames[back]}.first(drawn_size));
+        out.write_padding(frame_size - drawn_size);
+        out.write_bytes(get_frame());
+    }
+
+    void Lcd::load(state::Reader& in)
+    {
+        regs = in.read<Registers>();
+        counter_x = in.read<int>();
+        stat_signal = in.read<bool>();
+        drawing_mode = in.read<Mode>();
+        is_skipping_frame = in.read<bool>();
+
+        ++completed_frames; // before the front frame is overwritten
+        in.read_bytes(frames[back]);
+        in.read_bytes(frames[1 - back]);
+    }
+
+    template<int Address>
+    std::uint8_t Lcd::read_port() const
+    {
+        if constexpr (Address == 0xFF40) {
+            return regs.control;
+        }
+        else if constexpr (Address == 0xFF41) {
+            return regs.status;
+        }
+        else if constexpr (Address == 0xFF42) {
+            return regs.scroll_y;
+        }
+        else if constexpr (Address == 0xFF43) {
+            return regs.scroll_x;
+        }
+        else if constexpr (Address == 0xFF44) {
+            return regs.ly;
+        }
+        else if constexpr (Address == 0xFF45) {
+            return regs.ly_compare;
+        }
+        else if constexpr (Address == 0xFF46) {
+            return regs.dma_transfer;
+        }
+        else if constexpr (Address == 0xFF47) {
+            return regs.background_palette;
+        }
+        else if constexpr (Address == 0xFF48) {
+            return regs.object_palette_0;
+        }
+        else if constexpr (Address == 0xFF49) {
+            return regs.object_palette_1;
+        }
+        else if constexpr (Address == 0xFF4A) {
+            return regs.window_y;
+        }
+        else {
+            static_assert(Address == 0xFF4B, "Invalid address.");
+            return regs.window_x;
+        }
+    }
+
+    void Lcd::set_drawing_mode(Mode mode)
+    {
+        drawing_mode = mode;
+    }
+
+    void Lcd::set_before_line_change(std::function<void()> callback)
+    {
+        before_line_change = std::move(callback);
+    }
+
+    void Lcd::prepare_write(Mode reader)
+    {
+        if (drawing_mode == reader && before_line_change) {
+            before_line_change();
+        }
+    }
+
+    template<int Address>
+    void Lcd::write_port(std::uint8_t value)
+    {
+        // Everything but STAT, LY, LYC and DMA is read while a line is drawn. An OAM DMA writes through Oam.
+        if constexpr (Address != 0xFF41 && Address != 0xFF44 && Address != 0xFF45 && Address != 0xFF46) {
+            prepare_write(Mode::pixel_transfer);
+        }
+
+        if constexpr (Address == 0xFF40) {
+            regs.control = value;
+        }
+        else if constexpr (Address == 0xFF41) {
+            regs.status = value | 0b1000'0000;
+        }
+        else if constexpr (Address == 0xFF42) {
+            regs.scroll_y = value;
+        }
+        else if constexpr (Address == 0xFF43) {
+            regs.scroll_x = value;
+        }
+        else if constexpr (Address == 0xFF44) {
+            // read-only
+        }
+        else if constexpr (Address == 0xFF45) {
+            regs.ly_compare = value;
+        }
+        else if constexpr (Address == 0xFF46) {
+            regs.dma_transfer = value;
+        }
+        else if constexpr (Address == 0xFF47) {
+            regs.background_palette = value;
+        }
+        else if constexpr (Address == 0xFF48) {
+            regs.object_palette_0 = value;
+        }
+        else if constexpr (Address == 0xFF49) {
+            regs.object_palette_1 = value;
+        }
+        else if constexpr (Address == 0xFF4A) {
+            regs.window_y = value;
+        }
+        else {
+            static_assert(Address == 0xFF4B, "Invalid address.");
+            regs.window_x = value;
+        }
+    }
+
+    void Lcd::map_ports(io::PortTable& table)
+    {
+        io::bind_ports<0xFF40, 0xFF4B>(table, *this, true);
     }
 
     void Lcd::check_status(int x, int y)
     {
-        static bool signal{false};
         Mode mode{get_mode()};
 
         bool new_signal{
@@ -251,11 +384,11 @@ namespace gameboy::ppu {
             ((mode == Mode::oam_search) && is_mode_2_interrupt_enabled(regs.status))
         };
 
-        if (new_signal && !signal) {
+        if (new_signal && !stat_signal) {
             interrupt(system::Interrupt::lcd_stat);
         }
 
-        signal = new_signal;
+        stat_signal = new_signal;
     }
 
     void Lcd::set_coincidence_flag(bool condition)
@@ -1,12 +1,17 @@
 #ifndef PPU_LCD_H
 #define PPU_LCD_H
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <optional>
+#include <span>
 #include <vector>
 #include "io/port.hpp"
+#include "state.hpp"
 #include "system/interrupt.hpp"
-#include "ui/display.hpp"
+#include "tile.hpp"
 
 namespace gameboy::ppu {
     struct Position {
@@ -14,6 +19,17 @@ namespace gameboy::ppu {
         int y;
     };
 
+    /*
+        A pixel of a frame takes 4 bytes in the order A, B, G, R, which is what SDL calls
+        SDL_PIXELFORMAT_RGBA8888 on a little-endian host. Every pixel is produced here.
+    */
+    constexpr int bytes_per_pixel{4};
+
+    constexpr std::array<std::uint8_t, bytes_per_pixel> encode_pixel(std::uint8_t shade)
+    {
+        return {0xFF, shade, shade, shade};
+    }
+
     enum class Mode {
         h_blank = 0,
         v_blank = 1,
@@ -21,7 +37,7 @@ namespace gameboy::ppu {
         pixel_transfer = 3
     };
 
-    class Lcd : public io::Port {
+    class Lcd {
     public:
         Lcd(std::reference_wrapper<system::Interrupt> interrupt_ref);
         bool is_background_displayed() const;
@@ -38,11 +54,33 @@ namespace gameboy::ppu {
         std::uint8_t get_background_color(int index) const;
         std::uint8_t get_object_color(int palette_id, int index) const;
         Position get_window_position() const;
-        void update(SDL_Renderer& renderer, SDL_Texture& texture);
-        void append(std::uint8_t color);
+        void update();
+        std::optional<int> next_event() const; // m-cycles until the next mode or LY change
+        void draw(int x, std::uint8_t color); // on the current scanline
+        void draw(int x, std::span<const std::uint8_t> pixels); // encoded pixels from x onwards
+        PaletteColors get_palette_colors() const;
+        std::span<const std::uint8_t> get_frame() const; // the last complete frame, see frames for reading it from another thread
+        std::uint64_t get_completed_frames() const; // changes whenever the front frame does, at V-Blank or when a state is loaded
+        bool is_frame_unchanged(std::uint64_t completed) const; // whether a frame read since the count was taken is whole
+        void set_drawing(bool enabled); // whether the frames from the next V-Blank on are drawn
+        bool is_frame_skipped() const;
+
+        /*
+            The PPU tells which part of a line it's reading, since its pixel transfer lasts longer than
+            STAT shows when there are sprites on the line. Whatever writes what the PPU reads in the given
+            mode (the registers and the VRAM in the transfer, the OAM in the search) calls prepare_write
+            first, which gives the PPU a chance to finish drawing the line dot by dot.
+        */
+        void set_drawing_mode(Mode mode);
+        void set_before_line_change(std::function<void()> callback);
+        void prepare_write(Mode reader);
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
+
+        void map_ports(io::PortTable& table); // FF40-FF4B
 
-        virtual std::uint8_t read(int address) const override;
-        virtual void write(int address, std::uint8_t value) override;
+        template<int Address> std::uint8_t read_port() const;
+        template<int Address> void write_port(std::uint8_t value);
 
         static constexpr int pixels_per_scanline{160};
         static constexpr int scanlines_per_frame{144};
@@ -65,10 +103,25 @@ namespace gameboy::ppu {
         void check_status(int x, int y);
         void set_coincidence_flag(bool condition);
 
-        std::vector<std::uint8_t> frame_buffer{};
+        /*
+            The PPU draws into the back frame, which becomes the front one at V-Blank. The old front frame
+            becomes the back one then and is drawn over from line 0, a whole V-Blank after the count of
+            completed frames has moved on. Another thread can thus read the front frame in place: it takes
+            the count, reads the frame, and keeps what it read if is_frame_unchanged agrees afterwards.
+        */
+        std::array<std::vector<std::uint8_t>, 2> frames{};
+        int back{1};
+        std::atomic<int> front{0};
         Registers regs{};
+        int counter_x{};
+        bool stat_signal{false};
+        Mode drawing_mode{Mode::h_blank};
+        bool is_drawing{true};
+        bool is_skipping_frame{false}; // a skipped frame keeps the timing but leaves the frames untouched
+        std::atomic<std::uint64_t> completed_frames{};
 
         std::reference_wrapper<system::Interrupt> interrupt;
+        std::function<void()> before_line_change{};
     };
 }
 
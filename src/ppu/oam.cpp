@@ -1,4 +1,5 @@
 #include "oam.hpp"
+#include "lcd.hpp"
 
 namespace gameboy::ppu {
     Oam::Oam(std::reference_wrapper<Lcd> lcd_ref) : lcd{lcd_ref}
@@ -13,6 +14,17 @@ namespace gameboy::ppu {
 
     void Oam::write(int address, std::uint8_t value)
     {
+        lcd.get().prepare_write(Mode::oam_search);
         storage[address - 0xFE00] = value;
     }
+
+    void Oam::save(state::Writer& out) const
+    {
+        out.write_bytes(storage);
+    }
+
+    void Oam::load(state::Reader& in)
+    {
+        in.read_bytes(storage);
+    }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <vector>
+#include "state.hpp"
 
 namespace gameboy::ppu {
     class Lcd;
@@ -11,6 +12,8 @@ namespace gameboy::ppu {
         Oam(std::reference_wrapper<Lcd> lcd_ref);
         std::uint8_t read(int address) const;
         void write(int address, std::uint8_t value);
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
         friend class Core;
     private:
         std::reference_wrapper<Lcd> lcd;
@@ -1,4 +1,11 @@
 #include "tile.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define X86_TILE_KERNELS
+#endif
 
 namespace gameboy::ppu {
     int TileIdIndex::operator()(int tile_map_id, int y, int scroll_y, int x, int scroll_x, TileTrait tile_trait) const
@@ -47,4 +54,165 @@ namespace gameboy::ppu {
 
         return tile_data_begin + offset;
     }
+
+    void decode_rows_scalar(const std::uint8_t* p_data, std::uint8_t* p_color_ids, std::size_t row_count)
+    {
+        for (std::size_t row{0}; row < row_count; ++row) {
+            auto low_byte{p_data[row * 2]};
+            auto high_byte{p_data[row * 2 + 1]};
+            for (auto bit{7}; bit >= 0; --bit) {
+                *p_color_ids++ = static_cast<std::uint8_t>((((high_byte >> bit) & 1U) << 1) | ((low_byte >> bit) & 1U));
+            }
+        }
+    }
+
+    void apply_palettes_scalar(const std::uint8_t* p_indices, const PaletteColors& colors, std::uint8_t* p_pixels, std::size_t count)
+    {
+        for (std::size_t i{0}; i < count; ++i) {
+            std::memcpy(p_pixels + i * 4, &colors[p_indices[i]], 4);
+        }
+    }
+
+#ifdef X86_TILE_KERNELS
+    /*
+        A row of a tile is expanded by broadcasting its low and high bytes to 8 lanes, then
+        testing one bit per lane from the leftmost one. 8 rows (a whole tile) make a round.
+    */
+    __attribute__((target("sse2")))
+    __m128i expand_rows_sse2(__m128i low_bytes, __m128i high_bytes)
+    {
+        const auto bit_mask{_mm_set_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128)};
+        auto low_bits{_mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(low_bytes, bit_mask), bit_mask), _mm_set1_epi8(1))};
+        auto high_bits{_mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(high_bytes, bit_mask), bit_mask), _mm_set1_epi8(2))};
+        return _mm_or_si128(low_bits, high_bits);
+    }
+
+    __attribute__((target("sse2")))
+    std::size_t decode_rows_sse2(const std::uint8_t* p_data, std::uint8_t* p_color_ids, std::size_t row_count)
+    {
+        std::size_t row{0};
+        for (; row + 8 <= row_count; row += 8) {
+            auto data{_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_data + row * 2))};
+
+            // l0 ... l7 h0 ... h7
+            auto planes{_mm_packus_epi16(_mm_and_si128(data, _mm_set1_epi16(0x00FF)), _mm_srli_epi16(data, 8))};
+            auto low_pairs{_mm_unpacklo_epi8(planes, planes)};
+            auto high_pairs{_mm_unpackhi_epi8(planes, planes)};
+            auto low_quads{_mm_unpacklo_epi16(low_pairs, low_pairs)}; // rows 0 to 3
+            auto high_quads{_mm_unpacklo_epi16(high_pairs, high_pairs)};
+            auto* p_output{reinterpret_cast<__m128i*>(p_color_ids + row * 8)};
+            _mm_storeu_si128(p_output, expand_rows_sse2(_mm_unpacklo_epi32(low_quads, low_quads), _mm_unpacklo_epi32(high_quads, high_quads)));
+            _mm_storeu_si128(p_output + 1, expand_rows_sse2(_mm_unpackhi_epi32(low_quads, low_quads), _mm_unpackhi_epi32(high_quads, high_quads)));
+
+            low_quads = _mm_unpackhi_epi16(low_pairs, low_pairs); // rows 4 to 7
+            high_quads = _mm_unpackhi_epi16(high_pairs, high_pairs);
+            _mm_storeu_si128(p_output + 2, expand_rows_sse2(_mm_unpacklo_epi32(low_quads, low_quads), _mm_unpacklo_epi32(high_quads, high_quads)));
+            _mm_storeu_si128(p_output + 3, expand_rows_sse2(_mm_unpackhi_epi32(low_quads, low_quads), _mm_unpackhi_epi32(high_quads, high_quads)));
+        }
+
+        return row;
+    }
+
+    // data holds a whole tile in each 128-bit lane, and the selection picks the low bytes of 2 rows per lane.
+    __attribute__((target("avx2")))
+    __m256i expand_rows_avx2(__m256i data, __m256i low_selection)
+    {
+        const auto bit_mask{_mm256_set1_epi64x(0x0102'0408'1020'4080)};
+        const auto ones{_mm256_set1_epi8(1)};
+        auto low_bytes{_mm256_shuffle_epi8(data, low_selection)};
+        auto high_bytes{_mm256_shuffle_epi8(data, _mm256_add_epi8(low_selection, ones))};
+        auto low_bits{_mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(low_bytes, bit_mask), bit_mask), ones)};
+        auto high_bits{_mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(high_bytes, bit_mask), bit_mask), _mm256_set1_epi8(2))};
+        return _mm256_or_si256(low_bits, high_bits);
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t decode_rows_avx2(const std::uint8_t* p_data, std::uint8_t* p_color_ids, std::size_t row_count)
+    {
+        const auto upper_rows{_mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2, 4, 4, 4, 4, 4, 4, 4, 4, 6, 6, 6, 6, 6, 6, 6, 6)};
+        const auto lower_rows{_mm256_add_epi8(upper_rows, _mm256_set1_epi8(8))};
+
+        std::size_t row{0};
+        for (; row + 8 <= row_count; row += 8) {
+            auto data{_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_data + row * 2)))};
+            auto* p_output{reinterpret_cast<__m256i*>(p_color_ids + row * 8)};
+            _mm256_storeu_si256(p_output, expand_rows_avx2(data, upper_rows));
+            _mm256_storeu_si256(p_output + 1, expand_rows_avx2(data, lower_rows));
+        }
+
+        return row;
+    }
+
+    // The 12 colors are looked up as two tables of 8 lanes, and the upper one is taken for the indices above 7.
+    __attribute__((target("avx2")))
+    std::size_t apply_palettes_avx2(const std::uint8_t* p_indices, const PaletteColors& colors, std::uint8_t* p_pixels, std::size_t count)
+    {
+        auto lower_colors{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(colors.data()))};
+        std::array<std::uint32_t, 8> upper_table{};
+        std::memcpy(upper_table.data(), colors.data() + 8, 4 * sizeof(std::uint32_t));
+        auto upper_colors{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(upper_table.data()))};
+        const auto sevens{_mm256_set1_epi32(7)};
+
+        std::size_t i{0};
+        for (; i + 8 <= count; i += 8) {
+            auto indices{_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p_indices + i)))};
+            auto lower{_mm256_permutevar8x32_epi32(lower_colors, indices)};
+            auto upper{_mm256_permutevar8x32_epi32(upper_colors, indices)};
+            auto pixels{_mm256_blendv_epi8(lower, upper, _mm256_cmpgt_epi32(indices, sevens))};
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_pixels + i * 4), pixels);
+        }
+
+        return i;
+    }
+#endif
+
+    Isa detect_isa()
+    {
+#ifdef X86_TILE_KERNELS
+        static const Isa best{[]() {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return Isa::avx2;
+            }
+
+            return __builtin_cpu_supports("sse2") ? Isa::sse2 : Isa::scalar;
+        }()};
+
+        return best;
+#else
+        return Isa::scalar;
+#endif
+    }
+
+    void decode_tile_rows(std::span<const std::uint8_t> data, std::span<std::uint8_t> color_ids, [[maybe_unused]] Isa isa)
+    {
+        auto row_count{std::min(data.size() / 2, color_ids.size() / 8)};
+        std::size_t done{0};
+
+#ifdef X86_TILE_KERNELS
+        if (isa == Isa::avx2) {
+            done = decode_rows_avx2(data.data(), color_ids.data(), row_count);
+        }
+        else if (isa == Isa::sse2) {
+            done = decode_rows_sse2(data.data(), color_ids.data(), row_count);
+        }
+#endif
+
+        decode_rows_scalar(data.data() + done * 2, color_ids.data() + done * 8, row_count - done);
+    }
+
+    void apply_palettes(std::span<const std::uint8_t> indices, const PaletteColors& colors, std::span<std::uint8_t> pixels, [[maybe_unused]] Isa isa)
+    {
+        auto count{std::min(indices.size(), pixels.size() / 4)};
+        std::size_t done{0};
+
+#ifdef X86_TILE_KERNELS
+        // Without a byte shuffle, SSE2 takes more instructions for a lookup than the scalar loop does.
+        if (isa == Isa::avx2) {
+            done = apply_palettes_avx2(indices.data(), colors, pixels.data(), count);
+        }
+#endif
+
+        apply_palettes_scalar(indices.data() + done, colors, pixels.data() + done * 4, count - done);
+    }
 }
\ No newline at end of file
@@ -1,6 +1,10 @@
 #ifndef PPU_TILE_H
 #define PPU_TILE_H
 
+#include <array>
+#include <cstdint>
+#include <span>
+
 namespace gameboy::ppu {
     struct TileTrait {
         int width;
@@ -19,6 +23,27 @@ namespace gameboy::ppu {
     struct TileDataIndex {
         int operator()(int tile_id, int data_selection, int y, int scroll_y, bool is_flipped = false, TileTrait tile_trait = {8_px, 8_px}) const;
     };
+
+    /*
+        Kernels for converting many pixels at once. Each of them has a vectorized version for
+        x86 processors, and the best one the host supports is picked at runtime by default.
+    */
+    enum class Isa {
+        scalar,
+        sse2,
+        avx2
+    };
+
+    Isa detect_isa();
+
+    // the pixels of a frame (see encode_pixel) for the 4 colors of BGP, OBP0 and OBP1 in turn
+    using PaletteColors = std::array<std::uint32_t, 12>;
+
+    // Expand rows of 2bpp tile data (the low byte, then the high byte) into a color ID per pixel, leftmost first.
+    void decode_tile_rows(std::span<const std::uint8_t> data, std::span<std::uint8_t> color_ids, Isa isa = detect_isa());
+
+    // Convert indices into PaletteColors (palette * 4 + color ID) into the pixels of a frame.
+    void apply_palettes(std::span<const std::uint8_t> indices, const PaletteColors& colors, std::span<std::uint8_t> pixels, Isa isa = detect_isa());
 }
 
 #endif
\ No newline at end of file
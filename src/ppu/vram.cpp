@@ -1,12 +1,21 @@
 #include "vram.hpp"
+#include "lcd.hpp"
+#include "tile.hpp"
 
 namespace gameboy::ppu {
+    constexpr int bytes_per_tile{16};
+    constexpr int pixels_per_tile{64};
+    constexpr int tile_data_end{0x9800};
+
     Vram::Vram(std::reference_wrapper<Lcd> lcd_ref) : lcd{lcd_ref}
     {
         static constexpr int bank_size{0x2000};
 
         banks[0].resize(bank_size);
         std::swap(active_ram, banks[0]);
+
+        decoded_tiles.resize(tile_count * pixels_per_tile);
+        dirty_tiles.set();
     }
 
     std::uint8_t Vram::read(int address) const
@@ -16,6 +25,45 @@ namespace gameboy::ppu {
 
     void Vram::write(int address, std::uint8_t value)
     {
+        lcd.get().prepare_write(Mode::pixel_transfer);
         active_ram[address - 0x8000] = value;
+        if (address < tile_data_end) {
+            dirty_tiles.set((address - 0x8000) / bytes_per_tile);
+        }
+    }
+
+    std::uint8_t* Vram::data()
+    {
+        return active_ram.data();
+    }
+
+    std::span<const std::uint8_t, 8> Vram::get_tile_row(int address) const
+    {
+        auto tile_index{(address - 0x8000) / bytes_per_tile};
+        if (dirty_tiles.test(tile_index)) {
+            decode_tile(tile_index);
+        }
+
+        auto row{(address - 0x8000) % bytes_per_tile / 2};
+        return std::span<const std::uint8_t, 8>{decoded_tiles.data() + tile_index * pixels_per_tile + row * 8, 8};
+    }
+
+    void Vram::decode_tile(int tile_index) const
+    {
+        auto data{std::span{active_ram}.subspan(tile_index * bytes_per_tile, bytes_per_tile)};
+        auto color_ids{std::span{decoded_tiles}.subspan(tile_index * pixels_per_tile, pixels_per_tile)};
+        decode_tile_rows(data, color_ids);
+        dirty_tiles.reset(tile_index);
+    }
+
+    void Vram::save(state::Writer& out) const
+    {
+        out.write_bytes(active_ram);
+    }
+
+    void Vram::load(state::Reader& in)
+    {
+        in.read_bytes(active_ram);
+        dirty_tiles.set();
     }
 }
\ No newline at end of file
@@ -1,8 +1,11 @@
 #ifndef PPU_VRAM_H
 #define PPU_VRAM_H
 
+#include <bitset>
 #include <cstdint>
+#include <span>
 #include <vector>
+#include "state.hpp"
 
 namespace gameboy::ppu {
     class Lcd;
@@ -11,11 +14,26 @@ namespace gameboy::ppu {
         Vram(std::reference_wrapper<Lcd> lcd_ref);
         std::uint8_t read(int address) const;
         void write(int address, std::uint8_t value);
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
+        std::uint8_t* data();
+
+        /*
+            The tile data (0x8000-0x97FF) is also kept decoded as one color ID per pixel. A write
+            only marks its tile as dirty, and the tile is decoded again the next time it's read.
+        */
+        std::span<const std::uint8_t, 8> get_tile_row(int address) const; // the address of the row's low byte, leftmost pixel first
+
+        static constexpr int tile_count{384};
         friend class Core;
     private:
+        void decode_tile(int tile_index) const;
+
         std::reference_wrapper<Lcd> lcd;
         std::vector<std::uint8_t> active_ram{};
         std::vector<std::vector<std::uint8_t>> banks{{}};
+        mutable std::vector<std::uint8_t> decoded_tiles{};
+        mutable std::bitset<tile_count> dirty_tiles{};
     };
 }
 
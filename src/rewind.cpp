@@ -0,0 +1,244 @@
+#include "rewind.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace gameboy {
+    /*
+        Encoded frame: a sequence of runs, each of which is
+
+            std::uint32_t zero_count;    // bytes identical to the reference
+            std::uint32_t literal_count; // bytes that differ from it
+            std::uint8_t  literals[literal_count]; // XORed with the reference
+
+        The runs are found 8 bytes at a time, so an isolated change costs at most 8 literal bytes.
+    */
+    using Word = std::uint64_t;
+    using Count = std::uint32_t;
+
+    Word load_word(std::span<const std::uint8_t> data, std::size_t position)
+    {
+        if (data.empty()) {
+            return 0; // encode against zero
+        }
+
+        Word word{};
+        std::memcpy(&word, data.data() + position, sizeof(Word));
+        return word;
+    }
+
+    void apply_delta(std::span<const std::uint8_t> encoded, std::span<std::uint8_t> target)
+    {
+        std::size_t position{0};
+        auto* p_input{encoded.data()};
+        const auto* p_end{encoded.data() + encoded.size()};
+        while (p_input < p_end) {
+            Count zero_count{};
+            Count literal_count{};
+            std::memcpy(&zero_count, p_input, sizeof(Count));
+            std::memcpy(&literal_count, p_input + sizeof(Count), sizeof(Count));
+            p_input += 2 * sizeof(Count);
+
+            position += zero_count;
+            for (Count i{0}; i < literal_count; ++i) {
+                target[position++] ^= *p_input++;
+            }
+        }
+    }
+
+    RewindBuffer::RewindBuffer(const Machine& machine, std::size_t budget, int interval)
+        : ring(budget), keyframe_interval{std::max(interval, 1)}
+    {
+        auto state_size{machine.get_state_size()};
+        current.resize(state_size);
+        keyframe.resize(state_size);
+        encoded.resize(state_size + state_size / 2 + 4 * sizeof(Count)); // runs alternating every word at worst
+    }
+
+    void RewindBuffer::record(const Machine& machine)
+    {
+        machine.save_state(current);
+
+        auto is_keyframe{entries.empty() || frames_since_keyframe >= keyframe_interval};
+        std::optional<std::size_t> offset{};
+        if (!is_keyframe) {
+            encode(keyframe);
+            offset = allocate(encoded_size, false);
+
+            // The newest keyframe can't be evicted while the delta depends on it, so start over from here.
+            is_keyframe = !offset.has_value();
+        }
+
+        if (is_keyframe) {
+            encode({});
+            offset = allocate(encoded_size, true);
+            if (!offset.has_value()) {
+                throw std::length_error{"The rewind budget can't hold a single keyframe."};
+            }
+
+            std::copy(current.cbegin(), current.cend(), keyframe.begin());
+            frames_since_keyframe = 0;
+        }
+
+        std::memcpy(ring.data() + *offset, encoded.data(), encoded_size);
+        entries.push_back({.offset{*offset}, .size{encoded_size}, .is_keyframe{is_keyframe}});
+        head = *offset + encoded_size;
+        used += encoded_size;
+        ++frames_since_keyframe;
+    }
+
+    // Return the number of frames actually gone back: 0 restores the latest recorded one.
+    int RewindBuffer::rewind(Machine& machine, int frames)
+    {
+        if (entries.empty()) {
+            return 0;
+        }
+
+        frames = std::clamp(frames, 0, get_frame_count() - 1);
+        auto target{entries.size() - 1 - static_cast<std::size_t>(frames)};
+        auto base{target};
+        while (!entries[base].is_keyframe) {
+            --base; // the oldest entry is always a keyframe
+        }
+
+        std::fill(keyframe.begin(), keyframe.end(), std::uint8_t{0});
+        apply_delta(get_data(entries[base]), keyframe);
+        std::copy(keyframe.cbegin(), keyframe.cend(), current.begin());
+        if (target != base) {
+            apply_delta(get_data(entries[target]), current);
+        }
+
+        machine.load_state(current);
+
+        while (entries.size() - 1 > target) {
+            drop_newest();
+        }
+
+        frames_since_keyframe = static_cast<int>(target - base) + 1;
+        return frames;
+    }
+
+    void RewindBuffer::clear()
+    {
+        entries.clear();
+        head = 0;
+        used = 0;
+        frames_since_keyframe = 0;
+    }
+
+    int RewindBuffer::get_frame_count() const
+    {
+        return static_cast<int>(entries.size());
+    }
+
+    int RewindBuffer::get_keyframe_count() const
+    {
+        return static_cast<int>(std::ranges::count_if(entries, &Entry::is_keyframe));
+    }
+
+    std::size_t RewindBuffer::get_used_bytes() const
+    {
+        return used;
+    }
+
+    std::size_t RewindBuffer::get_budget() const
+    {
+        return ring.size();
+    }
+
+    std::size_t RewindBuffer::get_overhead() const
+    {
+        return current.size() + keyframe.size() + encoded.size();
+    }
+
+    void RewindBuffer::encode(std::span<const std::uint8_t> reference)
+    {
+        auto size{current.size()};
+        std::size_t position{0};
+        auto* p_output{encoded.data()};
+        while (position < size) {
+            auto zero_start{position};
+            while (position + sizeof(Word) <= size && load_word(current, position) == load_word(reference, position)) {
+                position += sizeof(Word);
+            }
+
+            auto literal_start{position};
+            while (position + sizeof(Word) <= size && load_word(current, position) != load_word(reference, position)) {
+                position += sizeof(Word);
+            }
+
+            if (position + sizeof(Word) > size) {
+                position = size; // the last few bytes are always literal
+            }
+
+            auto zero_count{static_cast<Count>(literal_start - zero_start)};
+            auto literal_count{static_cast<Count>(position - literal_start)};
+            std::memcpy(p_output, &zero_count, sizeof(Count));
+            std::memcpy(p_output + sizeof(Count), &literal_count, sizeof(Count));
+            p_output += 2 * sizeof(Count);
+
+            for (auto i{literal_start}; i < position; ++i) {
+                *p_output++ = static_cast<std::uint8_t>(current[i] ^ (reference.empty() ? 0 : reference[i]));
+            }
+        }
+
+        encoded_size = static_cast<std::size_t>(p_output - encoded.data());
+    }
+
+    /*
+        Find room for an entry after the newest one, evicting the oldest entries if needed.
+        The entries occupy the ring from the oldest one to head, wrapping around at most once.
+    */
+    std::optional<std::size_t> RewindBuffer::allocate(std::size_t size, bool may_evict_current)
+    {
+        if (size > ring.size()) {
+            return std::nullopt;
+        }
+
+        while (!entries.empty()) {
+            auto tail{entries.front().offset};
+            if (head > tail) {
+                if (head + size <= ring.size()) {
+                    return head;
+                }
+
+                if (size <= tail) {
+                    return 0;
+                }
+            }
+            else if (head + size <= tail) {
+                return head;
+            }
+
+            if (!may_evict_current && get_keyframe_count() == 1) {
+                return std::nullopt;
+            }
+
+            evict_oldest();
+        }
+
+        head = 0;
+        return 0;
+    }
+
+    // Drop the oldest keyframe along with the deltas that depend on it.
+    void RewindBuffer::evict_oldest()
+    {
+        do {
+            used -= entries.front().size;
+            entries.pop_front();
+        } while (!entries.empty() && !entries.front().is_keyframe);
+    }
+
+    void RewindBuffer::drop_newest()
+    {
+        used -= entries.back().size;
+        entries.pop_back();
+        head = entries.empty() ? 0 : entries.back().offset + entries.back().size;
+    }
+
+    std::span<const std::uint8_t> RewindBuffer::get_data(const Entry& entry) const
+    {
+        return std::span{ring}.subspan(entry.offset, entry.size);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <vector>
+#include "machine.hpp"
+
+namespace gameboy {
+    /*
+        Keep the recent frames of a machine within a fixed memory budget. Every frame is saved,
+        then XORed with the latest keyframe and run-length encoded. Most of a save state stays
+        the same from frame to frame, so a delta is usually a small fraction of a full state.
+        A keyframe is encoded against zero and taken every keyframe_interval frames, so that
+        any frame can be restored by decoding at most two entries.
+    */
+    class RewindBuffer {
+    public:
+        RewindBuffer(const Machine& machine, std::size_t budget, int keyframe_interval = 60);
+
+        void record(const Machine& machine);      // call once per frame
+        int rewind(Machine& machine, int frames); // restore an earlier frame and drop the later ones
+        void clear();
+
+        int get_frame_count() const;
+        int get_keyframe_count() const;
+        std::size_t get_used_bytes() const; // the encoded frames in the ring
+        std::size_t get_budget() const;
+        std::size_t get_overhead() const;   // the working buffers besides the ring
+    private:
+        struct Entry {
+            std::size_t offset;
+            std::size_t size;
+            bool is_keyframe;
+        };
+
+        void encode(std::span<const std::uint8_t> reference);
+        std::optional<std::size_t> allocate(std::size_t size, bool may_evict_current);
+        void evict_oldest();
+        void drop_newest();
+        std::span<const std::uint8_t> get_data(const Entry& entry) const;
+
+        std::vector<std::uint8_t> ring;
+        std::deque<Entry> entries{};
+        std::size_t head{}; // where the next entry goes
+        std::size_t used{};
+        int keyframe_interval;
+        int frames_since_keyframe{};
+
+        std::vector<std::uint8_t> current{};  // the state being recorded or restored
+        std::vector<std::uint8_t> keyframe{}; // the state that the newest entries are relative to
+        std::vector<std::uint8_t> encoded{};
+        std::size_t encoded_size{};
+    };
+}
+
+#endif
\ No newline at end of file
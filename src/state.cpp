@@ -0,0 +1,61 @@
+#include "state.hpp"
+#include <stdexcept>
+
+namespace gameboy::state {
+    Writer::Writer(std::span<std::uint8_t> buffer) : destination{buffer}
+    {
+    }
+
+    void Writer::write_bytes(std::span<const std::uint8_t> bytes)
+    {
+        if (position + bytes.size() <= destination.size()) {
+            std::memcpy(destination.data() + position, bytes.data(), bytes.size());
+        }
+
+        position += bytes.size();
+    }
+
+    void Writer::write_padding(std::size_t count)
+    {
+        if (position + count <= destination.size()) {
+            std::memset(destination.data() + position, 0, count);
+        }
+
+        position += count;
+    }
+
+    std::size_t Writer::get_size() const
+    {
+        return position;
+    }
+
+    Reader::Reader(std::span<const std::uint8_t> buffer) : source{buffer}
+    {
+    }
+
+    void Reader::read_bytes(std::span<std::uint8_t> bytes)
+    {
+        std::memcpy(bytes.data(), claim(bytes.size()), bytes.size());
+    }
+
+    void Reader::skip(std::size_t count)
+    {
+        claim(count);
+    }
+
+    std::size_t Reader::get_position() const
+    {
+        return position;
+    }
+
+    const std::uint8_t* Reader::claim(std::size_t count)
+    {
+        if (position + count > source.size()) {
+            throw std::out_of_range{"The save state is truncated."};
+        }
+
+        auto* p_data{source.data() + position};
+        position += count;
+        return p_data;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef STATE_H
+#define STATE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace gameboy::state {
+    /*
+        A save state is a flat sequence of fields in a fixed order. Every component writes
+        the same number of bytes each time, so that a state of a given machine always has
+        the same size and layout, and two of them can be compared byte by byte.
+    */
+    struct Header {
+        std::array<char, 4> magic{'M', 'B', 'S', 'T'};
+        std::uint32_t version{};
+        std::uint32_t size{}; // including the header
+    };
+
+    constexpr std::uint32_t version{9};
+
+    template<typename T>
+    concept Field = std::is_trivially_copyable_v<T> && (std::has_unique_object_representations_v<T> || std::is_same_v<T, bool>);
+
+    class Writer {
+    public:
+        explicit Writer(std::span<std::uint8_t> buffer);
+
+        template<Field T>
+        void write(const T& value)
+        {
+            if (position + sizeof(T) <= destination.size()) {
+                std::memcpy(destination.data() + position, &value, sizeof(T));
+            }
+
+            position += sizeof(T);
+        }
+
+        void write_bytes(std::span<const std::uint8_t> bytes);
+        void write_padding(std::size_t count); // keep the layout fixed after a field of variable length
+
+        // The bytes required so far, which may exceed the buffer; nothing is written past its end.
+        std::size_t get_size() const;
+    private:
+        std::span<std::uint8_t> destination;
+        std::size_t position{};
+    };
+
+    class Reader {
+    public:
+        explicit Reader(std::span<const std::uint8_t> buffer);
+
+        template<Field T>
+        T read()
+        {
+            T value{};
+            std::memcpy(&value, claim(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        void read_bytes(std::span<std::uint8_t> bytes);
+        void skip(std::size_t count);
+        std::size_t get_position() const;
+    private:
+        const std::uint8_t* claim(std::size_t count);
+
+        std::span<const std::uint8_t> source;
+        std::size_t position{};
+    };
+}
+
+#endif
\ No newline at end of file
@@ -1,18 +1,72 @@
 #include "interrupt.hpp"
+#include <bit>
 
 namespace gameboy::system {
     void Interrupt::operator()(Type option)
     {
         interrupt_flag.set(option);
+        update_pending();
     }
 
-    std::uint8_t Interrupt::read(int address) const
+    std::optional<Interrupt::Type> Interrupt::acknowledge()
     {
+        if (pending == 0) {
+            return std::nullopt;
+        }
+
+        // The lower the bit, the higher the priority.
+        auto option{static_cast<Type>(std::countr_zero(pending))};
+        interrupt_flag.reset(option);
+        update_pending();
+        return option;
+    }
+
+    std::uint8_t Interrupt::get_enable() const
+    {
+        return interrupt_enable;
+    }
+
+    void Interrupt::set_enable(std::uint8_t value)
+    {
+        interrupt_enable = value;
+        update_pending();
+    }
+
+    void Interrupt::save(state::Writer& out) const
+    {
+        out.write(static_cast<std::uint8_t>(interrupt_flag.to_ulong()));
+        out.write(interrupt_enable);
+    }
+
+    void Interrupt::load(state::Reader& in)
+    {
+        interrupt_flag = in.read<std::uint8_t>();
+        interrupt_enable = in.read<std::uint8_t>();
+        update_pending();
+    }
+
+    template<int Address>
+    std::uint8_t Interrupt::read_port() const
+    {
+        static_assert(Address == 0xFF0F, "Invalid address.");
         return static_cast<std::uint8_t>(interrupt_flag.to_ulong());
     }
 
-    void Interrupt::write(int address, std::uint8_t value)
+    template<int Address>
+    void Interrupt::write_port(std::uint8_t value)
     {
+        static_assert(Address == 0xFF0F, "Invalid address.");
         interrupt_flag = value | 0b1110'0000;
+        update_pending();
+    }
+
+    void Interrupt::map_ports(io::PortTable& table)
+    {
+        io::bind_ports<0xFF0F, 0xFF0F>(table, *this, false);
+    }
+
+    void Interrupt::update_pending()
+    {
+        pending = static_cast<std::uint8_t>(interrupt_flag.to_ulong() & interrupt_enable & 0x1F);
     }
 }
\ No newline at end of file
@@ -2,10 +2,13 @@
 #define SYSTEM_INTERRUPT_H
 
 #include <bitset>
+#include <cstdint>
+#include <optional>
 #include "io/port.hpp"
+#include "state.hpp"
 
 namespace gameboy::system {
-    class Interrupt : public io::Port {
+    class Interrupt {
     public:
         enum Type {
             vblank = 0,
@@ -17,9 +20,25 @@ namespace gameboy::system {
 
         void operator()(Type option);
 
-        virtual std::uint8_t read(int address) const override;
-        virtual void write(int address, std::uint8_t value) override;
+        // Whether an enabled interrupt is requested, regardless of IME. This is checked after every instruction.
+        bool has_pending() const
+        {
+            return pending != 0;
+        }
+
+        std::optional<Type> acknowledge(); // clear the request with the highest priority among the pending ones
+        std::uint8_t get_enable() const;   // IE (0xFFFF)
+        void set_enable(std::uint8_t value);
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
+
+        void map_ports(io::PortTable& table); // FF0F
+
+        template<int Address> std::uint8_t read_port() const;
+        template<int Address> void write_port(std::uint8_t value);
     private:
+        void update_pending();
+
         /*
             bit 0: V-Blank  Interrupt Request (INT 40h)  (1=Request)
             bit 1: LCD STAT Interrupt Request (INT 48h)  (1=Request)
@@ -28,6 +47,8 @@ namespace gameboy::system {
             bit 4: Joypad   Interrupt Request (INT 60h)  (1=Request)
         */
         std::bitset<8> interrupt_flag{0x1110'0000};
+        std::uint8_t interrupt_enable{};
+        std::uint8_t pending{}; // IF & IE, kept up to date whenever either of them changes
     };
 }
 
@@ -1,5 +1,4 @@
 #include "joypad.hpp"
-#include <stdexcept>
 
 namespace gameboy::system {
     enum SelectInput {
@@ -24,12 +23,26 @@ namespace gameboy::system {
         check_signal();
     }
 
-    std::uint8_t Joypad::read(int address) const
+    void Joypad::save(state::Writer& out) const
     {
-        if (address != 0xFF00) {
-            throw std::out_of_range{"Invalid address."};
-        }
+        out.write(signal);
+        out.write(static_cast<std::uint8_t>(button_pressed.to_ulong()));
+        out.write(static_cast<std::uint8_t>(direction_pressed.to_ulong()));
+        out.write(static_cast<std::uint8_t>(joypad_control.to_ulong()));
+    }
+
+    void Joypad::load(state::Reader& in)
+    {
+        signal = in.read<bool>();
+        button_pressed = in.read<std::uint8_t>();
+        direction_pressed = in.read<std::uint8_t>();
+        joypad_control = in.read<std::uint8_t>();
+    }
 
+    template<int Address>
+    std::uint8_t Joypad::read_port() const
+    {
+        static_assert(Address == 0xFF00, "Invalid address.");
         std::bitset<8> output{joypad_control};
 
         if (!joypad_control.test(direction)) {
@@ -43,8 +56,10 @@ namespace gameboy::system {
         return static_cast<std::uint8_t>(output.to_ulong());
     }
 
-    void Joypad::write(int address, std::uint8_t value)
+    template<int Address>
+    void Joypad::write_port(std::uint8_t value)
     {
+        static_assert(Address == 0xFF00, "Invalid address.");
         joypad_control = value | 0b1100'0000;
         check_signal();
     }
@@ -52,11 +67,16 @@ namespace gameboy::system {
     void Joypad::check_signal() const
     {
         // Check if any of the lower 4 bits is 0
-        bool new_signal{(read(0xFF00) & 0b0000'1111) != 0b0000'1111};
+        bool new_signal{(read_port<0xFF00>() & 0b0000'1111) != 0b0000'1111};
         if (signal && !new_signal) {
             interrupt(Interrupt::joypad);
         }
 
         signal = new_signal;
     }
+
+    void Joypad::map_ports(io::PortTable& table)
+    {
+        io::bind_ports<0xFF00, 0xFF00>(table, *this, false);
+    }
 }
\ No newline at end of file
@@ -6,9 +6,10 @@
 #include <memory>
 #include "io/port.hpp"
 #include "interrupt.hpp"
+#include "state.hpp"
 
 namespace gameboy::system {
-    class Joypad : public io::Port {
+    class Joypad {
     public:
         enum Input {
             a = 0,
@@ -23,9 +24,13 @@ namespace gameboy::system {
 
         Joypad(std::reference_wrapper<Interrupt> interrupt_ref);
         void press(Input option, bool pressed);
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
 
-        virtual std::uint8_t read(int address) const override;
-        virtual void write(int address, std::uint8_t value) override;
+        void map_ports(io::PortTable& table); // FF00
+
+        template<int Address> std::uint8_t read_port() const;
+        template<int Address> void write_port(std::uint8_t value);
     private:
         void check_signal() const;
 
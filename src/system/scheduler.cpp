@@ -0,0 +1,47 @@
+#include "scheduler.hpp"
+#include <algorithm>
+
+namespace gameboy::system {
+    void Scheduler::schedule(Event event, std::optional<int> cycles)
+    {
+        if (!cycles.has_value()) {
+            cancel(event);
+            return;
+        }
+
+        deadlines[event] = current + *cycles;
+    }
+
+    void Scheduler::cancel(Event event)
+    {
+        deadlines[event] = never;
+    }
+
+    void Scheduler::advance(int cycles)
+    {
+        current += cycles;
+    }
+
+    Scheduler::Timestamp Scheduler::now() const
+    {
+        return current;
+    }
+
+    Scheduler::Timestamp Scheduler::next_deadline() const
+    {
+        // A linear scan is cheaper than maintaining a heap for this few events.
+        return *std::min_element(deadlines.cbegin(), deadlines.cend());
+    }
+
+    void Scheduler::save(state::Writer& out) const
+    {
+        out.write(current);
+        out.write(deadlines);
+    }
+
+    void Scheduler::load(state::Reader& in)
+    {
+        current = in.read<Timestamp>();
+        deadlines = in.read<decltype(deadlines)>();
+    }
+}
\ No newline at end of file
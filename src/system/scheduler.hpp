@@ -0,0 +1,42 @@
+#ifndef SYSTEM_SCHEDULER_H
+#define SYSTEM_SCHEDULER_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include "state.hpp"
+
+namespace gameboy::system {
+    /*
+        Keep track of the next m-cycle at which each component needs the CPU to stop,
+        e.g. to raise an interrupt. The CPU may run freely until the earliest one.
+    */
+    class Scheduler {
+    public:
+        using Timestamp = std::int64_t; // m-cycle
+
+        enum Event {
+            timer = 0,
+            serial = 1,
+            lcd = 2,
+            stop = 3, // the end of the requested run
+            count = 4
+        };
+
+        void schedule(Event event, std::optional<int> cycles);
+        void cancel(Event event);
+        void advance(int cycles);
+        Timestamp now() const;
+        Timestamp next_deadline() const;
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
+
+        static constexpr Timestamp never{std::numeric_limits<Timestamp>::max()};
+    private:
+        Timestamp current{};
+        std::array<Timestamp, count> deadlines{never, never, never, never};
+    };
+}
+
+#endif
\ No newline at end of file
@@ -1,10 +1,10 @@
 #include "serial.hpp"
 #include <array>
 #include <limits>
-#include <iostream>
-#include <stdexcept>
 
 namespace gameboy::system {
+    constexpr int clock{128};
+
     enum Register {
         sb = 0xFF01,
         sc = 0xFF02
@@ -22,10 +22,6 @@ namespace gameboy::system {
 
     void Serial::tick()
     {
-        static constexpr int clock{128};
-        static bool signal{false};
-        static int bit_count{0};
-
         counter = (counter + 1) % (std::numeric_limits<std::uint8_t>::max() + 1);
         bool times_up{(counter % clock) == 0};
         bool new_signal{is_sender() && times_up};
@@ -42,7 +38,7 @@ namespace gameboy::system {
                         Although the CPU writes one byte at a time, the actual transfering
                         to another device is done by shifting out one bit per falling edge.
                     */
-                    std::cout << transfer_data;
+                    output.push_back(transfer_data);
                     bit_count = 0;
                     transfer_control.reset(transfering);
                     interrupt(Interrupt::serial);
@@ -55,6 +51,56 @@ namespace gameboy::system {
         signal = new_signal;
     }
 
+    void Serial::advance(int cycles)
+    {
+        if (!signal && !is_sender()) {
+            // Without the internal clock, only the counter is running.
+            counter = (counter + cycles) % (std::numeric_limits<std::uint8_t>::max() + 1);
+            return;
+        }
+
+        for (auto i{0}; i < cycles; ++i) {
+            tick();
+        }
+    }
+
+    std::optional<int> Serial::next_event() const
+    {
+        if (!is_transfering() || (!signal && !is_sender())) {
+            return std::nullopt;
+        }
+
+        if (signal) {
+            return 1;
+        }
+
+        return clock - counter % clock + 1;
+    }
+
+    const std::string& Serial::get_output() const
+    {
+        return output;
+    }
+
+    // The output is a log of the past transfers rather than a part of the hardware, so it isn't saved.
+    void Serial::save(state::Writer& out) const
+    {
+        out.write(counter);
+        out.write(bit_count);
+        out.write(signal);
+        out.write(transfer_data);
+        out.write(static_cast<std::uint8_t>(transfer_control.to_ulong()));
+    }
+
+    void Serial::load(state::Reader& in)
+    {
+        counter = in.read<int>();
+        bit_count = in.read<int>();
+        signal = in.read<bool>();
+        transfer_data = in.read<char>();
+        transfer_control = in.read<std::uint8_t>();
+    }
+
     bool Serial::is_transfering() const
     {
         return transfer_control.test(transfering);
@@ -65,29 +111,32 @@ namespace gameboy::system {
         return transfer_control.test(internal_clock);
     }
 
-    std::uint8_t Serial::read(int address) const
+    template<int Address>
+    std::uint8_t Serial::read_port() const
     {
-        switch (address) {
-            case sb:
-                return 0xFF; // Disable serial input.
-            case sc:
-                return static_cast<std::uint8_t>(transfer_control.to_ulong());
-            default:
-                throw std::out_of_range{"Invalid address."};
+        if constexpr (Address == sb) {
+            return 0xFF; // Disable serial input.
+        }
+        else {
+            static_assert(Address == sc, "Invalid address.");
+            return static_cast<std::uint8_t>(transfer_control.to_ulong());
         }
     }
 
-    void Serial::write(int address, std::uint8_t value)
+    template<int Address>
+    void Serial::write_port(std::uint8_t value)
     {
-        switch (address) {
-            case sb:
-                transfer_data = value;
-                return;
-            case sc:
-                transfer_control = value | 0b0111'1110;
-                return;
-            default:
-                throw std::out_of_range{"Invalid address."};
+        if constexpr (Address == sb) {
+            transfer_data = value;
+        }
+        else {
+            static_assert(Address == sc, "Invalid address.");
+            transfer_control = value | 0b0111'1110;
         }
     }
+
+    void Serial::map_ports(io::PortTable& table)
+    {
+        io::bind_ports<sb, sc>(table, *this, true);
+    }
 }
\ No newline at end of file
@@ -4,23 +4,36 @@
 #include <bitset>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include "io/port.hpp"
 #include "interrupt.hpp"
+#include "state.hpp"
 
 namespace gameboy::system {
-    class Serial : public io::Port {
+    class Serial {
     public:
         Serial(std::reference_wrapper<Interrupt> interrupt_ref);
         void tick();
+        void advance(int cycles);
+        std::optional<int> next_event() const; // m-cycles until the next bit is shifted out
+        const std::string& get_output() const;
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
 
-        virtual std::uint8_t read(int address) const override;
-        virtual void write(int address, std::uint8_t value) override;
+        void map_ports(io::PortTable& table); // FF01-FF02
+
+        template<int Address> std::uint8_t read_port() const;
+        template<int Address> void write_port(std::uint8_t value);
     private:
         bool is_transfering() const;
         bool is_sender() const;
 
         int counter{};
+        int bit_count{};
+        bool signal{false};
         char transfer_data{};
+        std::string output{}; // every byte sent so far
 
         /*
             bit 7: Transfer Start Flag (0=No Transfer, 1=Start)
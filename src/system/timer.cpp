@@ -1,9 +1,11 @@
 #include "timer.hpp"
+#include <algorithm>
 #include <array>
 #include <limits>
-#include <stdexcept>
 
 namespace gameboy::system {
+    constexpr std::array<int, 4> clock{256, 4, 16, 64};
+
     enum Register {
         div = 0xFF04,
         tima = 0xFF05,
@@ -17,10 +19,6 @@ namespace gameboy::system {
 
     void Timer::tick()
     {
-        static constexpr std::array<int, 4> clock{256, 4, 16, 64};
-        static bool signal{false};
-        static bool is_overflowed{false};
-
         // The divider counter isn't affected by the timer enable bit within the TAC register.
         counter = (counter + 1) % (std::numeric_limits<std::uint16_t>::max() + 1);
 
@@ -47,6 +45,50 @@ namespace gameboy::system {
         }
     }
 
+    void Timer::advance(int cycles)
+    {
+        while (cycles > 0) {
+            auto skipped{std::min(idle_cycles(), cycles)};
+            if (skipped > 0) {
+                counter = (counter + skipped) % (std::numeric_limits<std::uint16_t>::max() + 1);
+                cycles -= skipped;
+            }
+            else {
+                tick();
+                --cycles;
+            }
+        }
+    }
+
+    std::optional<int> Timer::next_event() const
+    {
+        if (is_overflowed) {
+            return 1;
+        }
+
+        auto period{clock[timer_control % clock.size()]};
+        auto increments{(std::numeric_limits<std::uint8_t>::max() + 1) - timer_counter};
+
+        // TIMA is incremented one cycle after the selected bit of the counter rises.
+        auto first_increment{0};
+        if (signal) {
+            first_increment = 1;
+        }
+        else if (is_enabled()) {
+            first_increment = period - counter % period + 1;
+        }
+        else {
+            return std::nullopt;
+        }
+
+        if (!is_enabled() && increments > 1) {
+            return std::nullopt;
+        }
+
+        // The interrupt is requested one cycle after the overflow.
+        return first_increment + (increments - 1) * period + 1;
+    }
+
     bool Timer::is_enabled() const
     {
         return (timer_control >> 2) & 1;
@@ -57,39 +99,79 @@ namespace gameboy::system {
         return static_cast<std::uint8_t>((counter >> 6) % 256);
     }
 
-    std::uint8_t Timer::read(int address) const
+    void Timer::save(state::Writer& out) const
+    {
+        out.write(counter);
+        out.write(timer_counter);
+        out.write(timer_modulus);
+        out.write(timer_control);
+        out.write(signal);
+        out.write(is_overflowed);
+    }
+
+    void Timer::load(state::Reader& in)
+    {
+        counter = in.read<int>();
+        timer_counter = in.read<int>();
+        timer_modulus = in.read<std::uint8_t>();
+        timer_control = in.read<std::uint8_t>();
+        signal = in.read<bool>();
+        is_overflowed = in.read<bool>();
+    }
+
+    int Timer::idle_cycles() const
+    {
+        if (signal || is_overflowed) {
+            return 0;
+        }
+
+        if (!is_enabled()) {
+            return std::numeric_limits<int>::max();
+        }
+
+        // Only the counter changes until it reaches the next multiple of the period.
+        auto period{clock[timer_control % clock.size()]};
+        return period - counter % period - 1;
+    }
+
+    template<int Address>
+    std::uint8_t Timer::read_port() const
     {
-        switch (address) {
-            case div:
-                return get_divider();
-            case tima:
-                return static_cast<std::uint8_t>(timer_counter);
-            case tma:
-                return timer_modulus;
-            case tac:
-                return timer_control;
-            default:
-                throw std::out_of_range{"Invalid address."};
+        if constexpr (Address == div) {
+            return get_divider();
+        }
+        else if constexpr (Address == tima) {
+            return static_cast<std::uint8_t>(timer_counter);
+        }
+        else if constexpr (Address == tma) {
+            return timer_modulus;
+        }
+        else {
+            static_assert(Address == tac, "Invalid address.");
+            return timer_control;
         }
     }
 
-    void Timer::write(int address, std::uint8_t value)
+    template<int Address>
+    void Timer::write_port(std::uint8_t value)
     {
-        switch (address) {
-            case div:
-                counter = 0;
-                return;
-            case tima:
-                timer_counter = value;
-                return;
-            case tma:
-                timer_modulus = value;
-                return;
-            case tac:
-                timer_control = value | 0b1111'1000;
-                return;
-            default:
-                throw std::out_of_range{"Invalid address."};
+        if constexpr (Address == div) {
+            counter = 0;
+        }
+        else if constexpr (Address == tima) {
+            timer_counter = value;
+        }
+        else if constexpr (Address == tma) {
+            timer_modulus = value;
         }
+        else {
+            static_assert(Address == tac, "Invalid address.");
+            timer_control = value | 0b1111'1000;
+        }
+    }
+
+    void Timer::map_ports(io::PortTable& table)
+    {
+        io::bind_ports<div, tac>(table, *this, true);
     }
 }
\ No newline at end of file
@@ -3,20 +3,30 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include "io/port.hpp"
 #include "interrupt.hpp"
+#include "state.hpp"
 
 namespace gameboy::system {
-    class Timer : public io::Port {
+    class Timer {
     public:
         Timer(std::reference_wrapper<Interrupt> interrupt_ref);
         void tick();
+        void advance(int cycles);
+        std::optional<int> next_event() const; // m-cycles until the timer interrupt is requested
         bool is_enabled() const;
         std::uint8_t get_divider() const;
+        void save(state::Writer& out) const;
+        void load(state::Reader& in);
 
-        virtual std::uint8_t read(int address) const override;
-        virtual void write(int address, std::uint8_t value) override;
+        void map_ports(io::PortTable& table); // FF04-FF07
+
+        template<int Address> std::uint8_t read_port() const;
+        template<int Address> void write_port(std::uint8_t value);
     private:
+        int idle_cycles() const;
+
         int counter{};
         int timer_counter{};
         std::uint8_t timer_modulus{};
@@ -31,6 +41,9 @@ namespace gameboy::system {
         */
         std::uint8_t timer_control{0b1111'1000};
 
+        bool signal{false};
+        bool is_overflowed{false};
+
         std::reference_wrapper<Interrupt> interrupt;
     };
 }
@@ -0,0 +1,86 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "support.hpp"
+
+/*
+    Checks that the PPU's pixel FIFO renderer draws frames without touching the heap once
+    the machine has warmed up: every global operator new is counted, and 60 frames of the
+    built-in busy ROM, with the background, the window and the sprites on, have to make none.
+*/
+namespace gameboy::test {
+    std::atomic<long> allocation_count{0};
+
+    void* allocate(std::size_t size)
+    {
+        ++allocation_count;
+        if (auto* p_memory{std::malloc(size == 0 ? 1 : size)}; p_memory != nullptr) {
+            return p_memory;
+        }
+
+        throw std::bad_alloc{};
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return gameboy::test::allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return gameboy::test::allocate(size);
+}
+
+void operator delete(void* p_memory) noexcept
+{
+    std::free(p_memory);
+}
+
+void operator delete[](void* p_memory) noexcept
+{
+    std::free(p_memory);
+}
+
+void operator delete(void* p_memory, std::size_t) noexcept
+{
+    std::free(p_memory);
+}
+
+void operator delete[](void* p_memory, std::size_t) noexcept
+{
+    std::free(p_memory);
+}
+
+int main()
+{
+    using namespace gameboy;
+
+    constexpr int warm_up_frames{30}; // the ROM takes a few frames to fill the VRAM before it turns the LCD on
+    constexpr int measured_frames{60};
+
+    auto rom_image{test::build_busy_rom()};
+    auto failures{0};
+    for (auto mode : {Machine::ExecutionMode::m_cycle, Machine::ExecutionMode::instruction}) {
+        auto p_machine{test::create_machine({}, rom_image, mode)};
+        p_machine->set_renderer(ppu::Renderer::fifo);
+        for (auto frame{0}; frame < warm_up_frames; ++frame) {
+            p_machine->step_frame();
+        }
+
+        auto before{test::allocation_count.load()};
+        for (auto frame{0}; frame < measured_frames; ++frame) {
+            p_machine->step_frame();
+        }
+
+        auto allocations{test::allocation_count.load() - before};
+        std::cout << (mode == Machine::ExecutionMode::m_cycle ? "m_cycle" : "instruction") << ": "
+            << allocations << " allocations in " << measured_frames << " frames\n";
+        if (allocations != 0) {
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
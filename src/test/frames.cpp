@@ -0,0 +1,66 @@
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "support.hpp"
+
+/*
+    Checks that another thread can read the front frame in place while the machine runs: every
+    frame it reads and finds unchanged afterwards is the very frame the emulating thread saw.
+*/
+int main()
+{
+    using namespace gameboy;
+
+    constexpr int frames{120};
+
+    auto rom_image{test::build_busy_rom(true)};
+    auto p_machine{test::create_machine({}, rom_image, Machine::ExecutionMode::instruction)};
+
+    // by the count of completed frames, which moves on by one at every step
+    std::vector<std::uint64_t> expected(frames + 1 + p_machine->get_completed_frames());
+    std::atomic<bool> is_done{false};
+
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> observed{};
+    auto discarded{0};
+    std::thread reader{[&]() {
+        auto last{p_machine->get_completed_frames()};
+        while (!is_done.load()) {
+            auto completed{p_machine->get_completed_frames()};
+            if (completed == last) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            auto hash{hash_bytes(p_machine->get_frame())};
+            if (p_machine->is_frame_unchanged(completed)) {
+                observed.emplace_back(completed, hash);
+                last = completed;
+            }
+            else {
+                ++discarded;
+            }
+        }
+    }};
+
+    for (auto frame{0}; frame < frames; ++frame) {
+        p_machine->step_frame();
+        expected[p_machine->get_completed_frames()] = hash_bytes(p_machine->get_frame());
+        std::this_thread::yield();
+    }
+
+    is_done = true;
+    reader.join();
+
+    auto mismatches{0};
+    for (const auto& [completed, hash] : observed) {
+        if (expected[completed] != hash) {
+            std::cout << "frame " << completed << " differs\n";
+            ++mismatches;
+        }
+    }
+
+    std::cout << observed.size() << " frames read in place, " << discarded << " discarded\n";
+    return (mismatches == 0 && !observed.empty()) ? 0 : 1;
+}
\ No newline at end of file
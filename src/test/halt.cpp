@@ -0,0 +1,34 @@
+#include <array>
+#include <iostream>
+#include "support.hpp"
+
+/*
+    Checks that skipping the halted CPU changes nothing: the frames and the save states of a ROM
+    which is halted most of the time are the same with and without it, in both execution modes.
+*/
+int main()
+{
+    using namespace gameboy;
+
+    constexpr int frames{200};
+    constexpr int state_interval{10};
+
+    auto rom_image{test::build_halt_rom()};
+    auto failures{0};
+    for (auto mode : {Machine::ExecutionMode::m_cycle, Machine::ExecutionMode::instruction}) {
+        std::array<std::uint64_t, 2> hashes{};
+        for (auto is_skipping : {false, true}) {
+            auto p_machine{test::create_machine({}, rom_image, mode)};
+            p_machine->set_halt_skipping(is_skipping);
+            hashes[is_skipping] = test::hash_frames(*p_machine, frames, state_interval);
+        }
+
+        std::cout << test::to_string(mode) << ": running " << std::hex << hashes[false]
+            << ", skipping " << hashes[true] << std::dec << (hashes[false] == hashes[true] ? "\n" : " differ\n");
+        if (hashes[false] != hashes[true]) {
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
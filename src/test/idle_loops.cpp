@@ -0,0 +1,49 @@
+#include <array>
+#include <iostream>
+#include "support.hpp"
+
+/*
+    Checks that skipping idle loops changes nothing: the frames and the save states of a ROM which
+    polls LY, STAT, IF and the work RAM are the same with and without it, in both execution modes.
+    Every one of its 6 loops has to be skipped, or the test proves nothing.
+*/
+int main()
+{
+    using namespace gameboy;
+
+    constexpr int frames{120};
+    constexpr int state_interval{10};
+    constexpr int polling_loops{6};
+
+    auto rom_image{test::build_polling_rom()};
+    auto failures{0};
+    for (auto mode : {Machine::ExecutionMode::m_cycle, Machine::ExecutionMode::instruction}) {
+        std::array<std::uint64_t, 2> hashes{};
+        for (auto is_skipping : {false, true}) {
+            auto p_machine{test::create_machine({}, rom_image, mode)};
+            p_machine->set_idle_loop_skipping(is_skipping);
+            hashes[is_skipping] = test::hash_frames(*p_machine, frames, state_interval);
+
+            if (is_skipping) {
+                const auto& loops{p_machine->get_idle_loops()};
+                for (const auto& [head, stats] : loops) {
+                    std::cout << test::to_string(mode) << ": loop at " << std::hex << head << std::dec
+                        << " skipped " << stats.skips << " times, " << stats.cycles << " m-cycles\n";
+                }
+
+                if (loops.size() < polling_loops) {
+                    std::cout << test::to_string(mode) << ": only " << loops.size() << " loops skipped\n";
+                    ++failures;
+                }
+            }
+        }
+
+        std::cout << test::to_string(mode) << ": running " << std::hex << hashes[false]
+            << ", skipping " << hashes[true] << std::dec << (hashes[false] == hashes[true] ? "\n" : " differ\n");
+        if (hashes[false] != hashes[true]) {
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include <array>
+#include <iostream>
+#include <string_view>
+#include "support.hpp"
+
+/*
+    Checks that the scanline renderer draws the same frames as the pixel FIFO, both on the busy
+    ROM and on its variant with raster effects, which writes the OAM, SCX, BGP and the tile map
+    at every line, before and during the pixel transfer.
+*/
+int main()
+{
+    using namespace gameboy;
+
+    constexpr int frames{40}; // the LCD is turned on after a few frames of filling the VRAM
+
+    auto failures{0};
+    for (auto has_raster_effects : {false, true}) {
+        auto rom_image{test::build_busy_rom(has_raster_effects)};
+        std::string_view rom_name{has_raster_effects ? "raster effects" : "busy"};
+        for (auto mode : {Machine::ExecutionMode::m_cycle, Machine::ExecutionMode::instruction}) {
+            std::array<std::uint64_t, 2> hashes{};
+            for (auto renderer : {ppu::Renderer::fifo, ppu::Renderer::scanline}) {
+                auto p_machine{test::create_machine({}, rom_image, mode)};
+                p_machine->set_renderer(renderer);
+                hashes[renderer == ppu::Renderer::scanline] = test::hash_frames(*p_machine, frames);
+            }
+
+            auto [fifo, scanline]{hashes};
+            std::cout << rom_name << ", " << test::to_string(mode) << ": fifo " << std::hex << fifo
+                << ", scanline " << scanline << std::dec << (fifo == scanline ? "\n" : " differ\n");
+            if (fifo != scanline) {
+                ++failures;
+            }
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "rewind.hpp"
+#include "support.hpp"
+
+/*
+    Records the built-in busy ROM into rewind buffers small enough to wrap around and evict
+    their oldest keyframes many times over, then goes back by various amounts. Each restored
+    machine has to save exactly the state recorded for that frame, and the recording carries
+    on from there. The slowest restore is reported.
+*/
+namespace gameboy::test {
+    using Clock = std::chrono::steady_clock;
+
+    struct Budget {
+        std::size_t states; // the ring size in full save states
+        int keyframe_interval;
+    };
+
+    class RewindCheck {
+    public:
+        RewindCheck(Machine& machine, Budget budget)
+            : machine{machine}
+            , buffer{machine, budget.states * machine.get_state_size(), budget.keyframe_interval}
+            , state(machine.get_state_size())
+        {
+        }
+
+        void record(int frames)
+        {
+            for (auto frame{0}; frame < frames; ++frame) {
+                machine.step_frame();
+                buffer.record(machine);
+                machine.save_state(state);
+                recorded.push_back(state);
+                ++recorded_count;
+            }
+        }
+
+        // Whether the machine goes back by the given number of frames to the state recorded for that frame.
+        bool rewind(int frames)
+        {
+            auto expected_frames{std::min(frames, buffer.get_frame_count() - 1)};
+            auto start{Clock::now()};
+            auto actual_frames{buffer.rewind(machine, frames)};
+            slowest = std::max(slowest, Clock::now() - start);
+
+            recorded.resize(recorded.size() - static_cast<std::size_t>(actual_frames));
+            machine.save_state(state);
+            return actual_frames == expected_frames && state == recorded.back();
+        }
+
+        bool has_evicted() const
+        {
+            return buffer.get_frame_count() < recorded_count;
+        }
+
+        Clock::duration get_slowest() const
+        {
+            return slowest;
+        }
+    private:
+        Machine& machine;
+        RewindBuffer buffer;
+        std::vector<std::uint8_t> state;
+        std::vector<std::vector<std::uint8_t>> recorded{};
+        int recorded_count{};
+        Clock::duration slowest{};
+    };
+}
+
+int main()
+{
+    using namespace gameboy;
+
+    constexpr int warm_up_frames{10};
+    constexpr int recorded_frames{200};
+    constexpr int frames_after_rewind{20};
+    constexpr test::Budget budgets[]{{.states{2}, .keyframe_interval{1}}, {.states{4}, .keyframe_interval{8}}, {.states{12}, .keyframe_interval{60}}};
+
+    auto rom_image{test::build_busy_rom()};
+    auto failures{0};
+    for (const auto& budget : budgets) {
+        auto p_machine{test::create_machine({}, rom_image, Machine::ExecutionMode::instruction)};
+        for (auto frame{0}; frame < warm_up_frames; ++frame) {
+            p_machine->step_frame();
+        }
+
+        test::RewindCheck check{*p_machine, budget};
+        check.record(recorded_frames);
+        auto interval{budget.keyframe_interval};
+        for (auto frames : {0, 1, 3, interval - 1, interval, interval + 1, 2 * interval + 5, 1000}) {
+            if (!check.rewind(frames)) {
+                std::cout << budget.states << " states, keyframe interval " << interval << ": going back "
+                    << frames << " frames doesn't restore the recorded state\n";
+                ++failures;
+            }
+
+            check.record(frames_after_rewind);
+        }
+
+        if (!check.has_evicted()) {
+            std::cout << budget.states << " states, keyframe interval " << interval << ": nothing has been evicted\n";
+            ++failures;
+        }
+
+        std::cout << budget.states << " states, keyframe interval " << interval << ": slowest restore "
+            << std::chrono::duration_cast<std::chrono::microseconds>(check.get_slowest()).count() << " us\n";
+    }
+
+    try {
+        auto p_machine{test::create_machine({}, rom_image, Machine::ExecutionMode::instruction)};
+        RewindBuffer buffer{*p_machine, p_machine->get_state_size() / 16};
+        buffer.record(*p_machine);
+        std::cout << "A budget too small for a keyframe is accepted\n";
+        ++failures;
+    }
+    catch (const std::length_error&) {
+    }
+
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "support.hpp"
+
+/*
+    Usage: gameboy-stress [rom] [--machines N] [--frames N]
+
+    Runs N machines at once, each on its own thread, and checks that every one of them ends
+    up bit for bit where the same machine ends up when they run one at a time: the same
+    save state and the same frames. Without a ROM file, the built-in busy ROM is used.
+*/
+namespace gameboy::test {
+    struct Outcome {
+        std::vector<std::uint8_t> state{};
+        std::uint64_t frame_hash{};
+        std::string error{};
+
+        bool operator==(const Outcome&) const = default;
+    };
+
+    struct Setup {
+        std::string rom_file{};
+        std::vector<std::uint8_t> rom_image{};
+        Machine::ExecutionMode mode{};
+        int frames{};
+    };
+
+    Outcome run_machine(const Setup& setup)
+    {
+        Outcome outcome{};
+        try {
+            auto p_machine{create_machine(setup.rom_file, setup.rom_image, setup.mode)};
+            outcome.frame_hash = initial_hash;
+            for (auto frame{0}; frame < setup.frames; ++frame) {
+                p_machine->step_frame();
+                outcome.frame_hash = hash_bytes(p_machine->get_frame(), outcome.frame_hash);
+            }
+
+            outcome.state.resize(p_machine->get_state_size());
+            p_machine->save_state(outcome.state);
+        }
+        catch (const std::exception& error) {
+            outcome.error = error.what();
+        }
+
+        return outcome;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace gameboy;
+
+    test::Setup setup{.frames{60}};
+    auto machine_count{std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 2, 8)};
+    for (auto i{1}; i < argc; ++i) {
+        std::string_view option{argv[i]};
+        if (option == "--machines" && i + 1 < argc) {
+            machine_count = std::max(std::stoi(argv[++i]), 1);
+        }
+        else if (option == "--frames" && i + 1 < argc) {
+            setup.frames = std::max(std::stoi(argv[++i]), 1);
+        }
+        else {
+            setup.rom_file = option;
+        }
+    }
+
+    if (setup.rom_file.empty()) {
+        setup.rom_image = test::build_busy_rom();
+    }
+
+    auto failures{0};
+    for (auto mode : {Machine::ExecutionMode::m_cycle, Machine::ExecutionMode::instruction}) {
+        setup.mode = mode;
+
+        std::vector<test::Outcome> sequential(machine_count);
+        for (auto& outcome : sequential) {
+            outcome = test::run_machine(setup);
+        }
+
+        std::vector<test::Outcome> concurrent(machine_count);
+        {
+            std::vector<std::jthread> threads{};
+            for (auto& outcome : concurrent) {
+                threads.emplace_back([&setup, &outcome]() { outcome = test::run_machine(setup); });
+            }
+        }
+
+        for (auto i{0}; i < machine_count; ++i) {
+            const auto& expected{sequential[i]};
+            const auto& actual{concurrent[i]};
+            if (!expected.error.empty() || !actual.error.empty()) {
+                std::cout << test::to_string(mode) << " #" << i << ": " << expected.error << actual.error << "\n";
+                ++failures;
+            }
+            else if (actual != expected || expected != sequential.front()) {
+                std::cout << test::to_string(mode) << " #" << i << ": "
+                    << (actual.state != expected.state ? "the save state differs" : "the frames differ") << "\n";
+                ++failures;
+            }
+        }
+
+        std::cout << test::to_string(mode) << ": " << machine_count << " machines, " << setup.frames << " frames, frame hash "
+            << std::hex << sequential.front().frame_hash << std::dec << "\n";
+    }
+
+    std::cout << (failures == 0 ? "All machines match.\n" : "Some machines don't match.\n");
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
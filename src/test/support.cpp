@@ -0,0 +1,306 @@
+#include "support.hpp"
+#include <initializer_list>
+#include "cartridge/banking.hpp"
+#include "cartridge/mbc.hpp"
+#include "cartridge/storage.hpp"
+
+namespace gameboy::test {
+    std::vector<std::uint8_t> build_busy_rom(bool has_raster_effects)
+    {
+        constexpr int bank_size{0x4000};
+        std::vector<std::uint8_t> rom(4 * bank_size, 0x00);
+
+        auto at{0};
+        auto emit = [&rom, &at](std::initializer_list<int> bytes) {
+            for (auto byte : bytes) {
+                rom[at++] = static_cast<std::uint8_t>(byte);
+            }
+        };
+
+        // the operand of a JR emitted at the current position
+        auto relative = [&at](int target) {
+            return (target - (at + 2)) & 0xFF;
+        };
+
+        at = 0x0040;
+        emit({0xC3, 0x00, 0x02}); // V-Blank: jp 0x0200
+        if (has_raster_effects) {
+            at = 0x0048;
+            emit({0xC3, 0x80, 0x02}); // LCD STAT: jp 0x0280
+        }
+        at = 0x0050;
+        emit({0xC3, 0x40, 0x02}); // timer: jp 0x0240
+        at = 0x0100;
+        emit({0x00, 0xC3, 0x50, 0x01}); // nop; jp 0x0150
+        rom[0x0147] = 0x01; // MBC1
+        rom[0x0148] = 0x01; // 4 banks
+
+        at = 0x0150;
+        emit({0x31, 0xF0, 0xDF});             // ld sp, 0xDFF0
+        emit({0xAF, 0xE0, 0x40});             // xor a; ldh (LCDC), a
+        emit({0x21, 0x00, 0x80, 0x06, 0x5A}); // ld hl, 0x8000; ld b, 0x5A
+
+        // B steps through an 8-bit LFSR, which is mixed with H to tell the pages apart.
+        auto fill_vram{at};
+        emit({0x78, 0x87, 0x30, 0x02, 0xEE, 0x1D}); // ld a, b; add a, a; jr nc, +2; xor 0x1D
+        emit({0x47, 0xAC, 0x22});                   // ld b, a; xor h; ld (hl+), a
+        emit({0x7C, 0xFE, 0xA0});                   // ld a, h; cp 0xA0
+        emit({0x20, relative(fill_vram)});          // jr nz
+
+        emit({0x21, 0x00, 0xFE}); // ld hl, 0xFE00
+        auto fill_oam{at};
+        emit({0x78, 0x87, 0x30, 0x02, 0xEE, 0x1D}); // the same LFSR
+        emit({0x47, 0xE6, 0x9F, 0x22});             // ld b, a; and 0x9F to keep most sprites on the screen; ld (hl+), a
+        emit({0x7D, 0xFE, 0xA0});                   // ld a, l; cp 0xA0
+        emit({0x20, relative(fill_oam)});           // jr nz
+
+        emit({0x3E, 0xE4, 0xE0, 0x47, 0xE0, 0x48});             // BGP, OBP0
+        emit({0x3E, 0x1B, 0xE0, 0x49});                         // OBP1
+        emit({0x3E, 0x58, 0xE0, 0x4B});                         // WX
+        emit({0x3E, 0x80, 0xE0, 0x26, 0x3E, 0x77, 0xE0, 0x24}); // NR52, NR50
+        emit({0x3E, 0xFF, 0xE0, 0x25, 0x3E, 0xF0, 0xE0, 0x12}); // NR51, NR12
+        emit({0x3E, 0x87, 0xE0, 0x14});                         // NR14: trigger channel 1
+        emit({0x3E, 0xC0, 0xE0, 0x06, 0x3E, 0x05, 0xE0, 0x07}); // TMA, TAC: an overflow every 256 m-cycles
+        if (has_raster_effects) {
+            emit({0x3E, 0x20, 0xE0, 0x41, 0x3E, 0x07, 0xE0, 0xFF}); // STAT: mode 2; IE: V-Blank, LCD STAT and timer
+        }
+        else {
+            emit({0x3E, 0x05, 0xE0, 0xFF}); // IE: V-Blank and timer
+        }
+        emit({0x3E, 0xF3, 0xE0, 0x40, 0xFB});                   // LCDC: everything on; ei
+
+        emit({0x0E, 0x01}); // ld c, 1
+        auto main_loop{at};
+        emit({0x79, 0xEA, 0x00, 0x20});                         // ld a, c; ld (0x2000), a
+        emit({0xCD, 0x00, 0x40});                               // call 0x4000
+        emit({0x0C, 0x79, 0xFE, 0x04, 0x20, 0x02, 0x0E, 0x01}); // inc c; if c == 4, ld c, 1
+        emit({0x76});                                           // halt
+        emit({0x18, relative(main_loop)});                      // jr
+
+        at = 0x0200;
+        emit({0xF5});                                     // push af
+        emit({0xF0, 0x43, 0x3C, 0xE0, 0x43});             // SCX += 1
+        emit({0xF0, 0x42, 0xC6, 0x03, 0xE0, 0x42});       // SCY += 3
+        emit({0xFA, 0x01, 0xFE, 0x3C, 0xEA, 0x01, 0xFE}); // move the first sprite
+        emit({0xF1, 0xD9});                               // pop af; reti
+
+        at = 0x0240;
+        emit({0xF5, 0xE5});                   // push af; push hl
+        emit({0x21, 0x00, 0xC1, 0x34, 0x7E}); // ld hl, 0xC100; inc (hl); ld a, (hl)
+        emit({0xE6, 0x7F, 0xE0, 0x4A});       // and 0x7F; ldh (WY), a
+        emit({0xE1, 0xF1, 0xD9});             // pop hl; pop af; reti
+
+        if (has_raster_effects) {
+            // At the start of a line, the sprite search is nearly over, and the delay moves the rest over the pixel transfer.
+            at = 0x0280;
+            emit({0xF5, 0xC5});                         // push af; push bc
+            emit({0xF0, 0x44, 0xEA, 0x05, 0xFE});       // ldh a, (LY); move the second sprite
+            emit({0xE6, 0x07, 0x47, 0x04});             // and 7; ld b, a; inc b
+            auto delay{at};
+            emit({0x05});                               // dec b
+            emit({0x20, relative(delay)});              // jr nz
+            emit({0xF0, 0x43, 0x3C, 0xE0, 0x43});       // SCX += 1
+            emit({0xF0, 0x47, 0x0F, 0x0F, 0xE0, 0x47}); // rotate BGP by a color
+            emit({0xF0, 0x44, 0xEA, 0x10, 0x9A});       // ldh a, (LY); write the tile map
+            emit({0xC1, 0xF1, 0xD9});                   // pop bc; pop af; reti
+        }
+
+        // Each bank mixes 64 bytes of the work RAM in its own way.
+        for (auto bank{1}; bank < 4; ++bank) {
+            at = bank * bank_size;
+            emit({0x21, 0x00, 0xC0, 0x06, 0x40});        // ld hl, 0xC000; ld b, 64
+            auto mix{at};
+            emit({0x7E, 0xC6, bank * 0x25, 0xA9, 0x22}); // ld a, (hl); add a, n; xor c; ld (hl+), a
+            emit({0x05});                                // dec b
+            emit({0x20, relative(mix)});                 // jr nz
+            emit({0xC9});                                // ret
+        }
+
+        return rom;
+    }
+
+    std::vector<std::uint8_t> build_halt_rom()
+    {
+        std::vector<std::uint8_t> rom(0x8000, 0x00);
+
+        auto at{0};
+        auto emit = [&rom, &at](std::initializer_list<int> bytes) {
+            for (auto byte : bytes) {
+                rom[at++] = static_cast<std::uint8_t>(byte);
+            }
+        };
+
+        auto relative = [&at](int target) {
+            return (target - (at + 2)) & 0xFF;
+        };
+
+        // Mix TIMA and STAT into 0xC002, so that an interrupt served a little late leaves a trace.
+        auto sample_timing = [&emit]() {
+            emit({0xE5, 0x21, 0x02, 0xC0});       // push hl; ld hl, 0xC002
+            emit({0xF0, 0x05, 0x86, 0x77});       // ldh a, (TIMA); add a, (hl); ld (hl), a
+            emit({0xF0, 0x41, 0xAE, 0x77, 0xE1}); // ldh a, (STAT); xor (hl); ld (hl), a; pop hl
+        };
+
+        at = 0x0040;
+        emit({0xC3, 0x00, 0x02}); // V-Blank: jp 0x0200
+        at = 0x0048;
+        emit({0xC3, 0x40, 0x02}); // LCD STAT: jp 0x0240
+        at = 0x0050;
+        emit({0xC3, 0x60, 0x02}); // timer: jp 0x0260
+        at = 0x0058;
+        emit({0xC3, 0x80, 0x02}); // serial: jp 0x0280
+        at = 0x0100;
+        emit({0x00, 0xC3, 0x50, 0x01}); // nop; jp 0x0150
+
+        at = 0x0150;
+        emit({0x31, 0xF0, 0xDF});                               // ld sp, 0xDFF0
+        emit({0x3E, 0x30, 0xE0, 0x45, 0x3E, 0x40, 0xE0, 0x41}); // LYC; STAT: LYC coincidence
+        emit({0x3E, 0x00, 0xE0, 0x06, 0x3E, 0x05, 0xE0, 0x07}); // TMA, TAC: TIMA counts every 4 m-cycles
+        emit({0x3E, 0x77, 0xE0, 0x24, 0x3E, 0xFF, 0xE0, 0x25}); // NR50, NR51
+        emit({0x3E, 0x81, 0xE0, 0x02});                         // SC: start a transfer on the internal clock
+        emit({0x3E, 0x91, 0xE0, 0x40});                         // LCDC: the LCD and the background on
+        emit({0xAF, 0xE0, 0x0F, 0x3E, 0x0F, 0xE0, 0xFF, 0xFB}); // IF = 0; IE: all but the joypad; ei
+
+        auto main_loop{at};
+        emit({0x76});                      // halt, to be woken up by a handler
+        emit({0xF3, 0x76, 0xFB});          // di; halt, to be woken up without one, which runs after ei
+        emit({0x18, relative(main_loop)}); // jr
+
+        at = 0x0200;
+        emit({0xF5});                                           // push af
+        sample_timing();
+        emit({0xFA, 0x00, 0xC0, 0x3C, 0xEA, 0x00, 0xC0});       // count the frames at 0xC000
+        emit({0xE6, 0x02, 0x0F, 0x0F, 0xE0, 0x26});             // and 2; rrca; rrca; ldh (NR52), a
+        emit({0x3E, 0xF0, 0xE0, 0x12, 0x3E, 0x87, 0xE0, 0x14}); // NR12, NR14: trigger channel 1 if the PSG is on
+        emit({0xF0, 0x07, 0xEE, 0x04, 0xE0, 0x07});             // ldh a, (TAC); xor 4; ldh (TAC), a
+        emit({0xF1, 0xD9});                                     // pop af; reti
+
+        at = 0x0240;
+        emit({0xF5});                                     // push af
+        sample_timing();
+        emit({0xF0, 0x45, 0xC6, 0x25, 0xFE, 0x9A});       // ldh a, (LYC); add a, 37; cp 154
+        emit({0x38, 0x02, 0xD6, 0x9A, 0xE0, 0x45});       // jr c, +2; sub a, 154; ldh (LYC), a
+        emit({0xF1, 0xD9});                               // pop af; reti
+
+        at = 0x0260;
+        emit({0xF5});                                     // push af
+        sample_timing();
+        emit({0xFA, 0x01, 0xC0, 0x3C, 0xEA, 0x01, 0xC0}); // count the overflows at 0xC001
+        emit({0xF1, 0xD9});                               // pop af; reti
+
+        at = 0x0280;
+        emit({0xF5});                                     // push af
+        emit({0xFA, 0x02, 0xC0, 0xE0, 0x01});             // send the timing samples
+        emit({0x3E, 0x81, 0xE0, 0x02});                   // SC: start the next transfer
+        emit({0xF1, 0xD9});                               // pop af; reti
+
+        return rom;
+    }
+
+    std::vector<std::uint8_t> build_polling_rom()
+    {
+        std::vector<std::uint8_t> rom(0x8000, 0x00);
+
+        auto at{0};
+        auto emit = [&rom, &at](std::initializer_list<int> bytes) {
+            for (auto byte : bytes) {
+                rom[at++] = static_cast<std::uint8_t>(byte);
+            }
+        };
+
+        auto relative = [&at](int target) {
+            return (target - (at + 2)) & 0xFF;
+        };
+
+        auto sample_timing = [&emit]() {
+            emit({0x21, 0x02, 0xC0});       // ld hl, 0xC002
+            emit({0xF0, 0x05, 0x86, 0x77}); // ldh a, (TIMA); add a, (hl); ld (hl), a
+            emit({0xF0, 0x04, 0xAE, 0x77}); // ldh a, (DIV); xor (hl); ld (hl), a
+        };
+
+        at = 0x0050;
+        emit({0xC3, 0x00, 0x02}); // timer: jp 0x0200
+        at = 0x0100;
+        emit({0x00, 0xC3, 0x50, 0x01}); // nop; jp 0x0150
+
+        at = 0x0150;
+        emit({0x31, 0xF0, 0xDF});                               // ld sp, 0xDFF0
+        emit({0x3E, 0x00, 0xE0, 0x06, 0x3E, 0x05, 0xE0, 0x07}); // TMA, TAC: an overflow every 1024 m-cycles
+        emit({0x3E, 0x91, 0xE0, 0x40});                         // LCDC: the LCD and the background on
+        emit({0xAF, 0xE0, 0x0F, 0x3E, 0x04, 0xE0, 0xFF, 0xFB}); // IF = 0; IE: timer; ei
+        emit({0x0E, 0x00});                                     // ld c, 0
+
+        auto main_loop{at};
+        auto wait_v_blank{at};
+        emit({0xF0, 0x44, 0xFE, 0x90});       // ldh a, (LY); cp 144
+        emit({0x20, relative(wait_v_blank)}); // jr nz
+        sample_timing();
+        auto wait_line{at};
+        emit({0xF0, 0x44, 0xB9});          // ldh a, (LY); cp c
+        emit({0x20, relative(wait_line)}); // jr nz
+        sample_timing();
+        auto wait_h_blank{at};
+        emit({0xF0, 0x41, 0xE6, 0x03});       // ldh a, (STAT); and 3
+        emit({0x20, relative(wait_h_blank)}); // jr nz
+        sample_timing();
+        auto wait_transfer{at};
+        emit({0xF0, 0x41, 0xE6, 0x03, 0xFE, 0x03}); // ldh a, (STAT); and 3; cp 3
+        emit({0x20, relative(wait_transfer)});      // jr nz
+        sample_timing();
+
+        emit({0xF3, 0xAF, 0xE0, 0x0F}); // di; xor a; ldh (IF), a
+        auto wait_flag{at};
+        emit({0xF0, 0x0F, 0xE6, 0x04});    // ldh a, (IF); and 4
+        emit({0x28, relative(wait_flag)}); // jr z
+        emit({0xFB});                      // ei, which runs the handler
+        sample_timing();
+
+        emit({0xFA, 0x01, 0xC0, 0x47}); // ld a, (0xC001); ld b, a
+        auto wait_handler{at};
+        emit({0xFA, 0x01, 0xC0, 0xB8});       // ld a, (0xC001); cp b
+        emit({0x28, relative(wait_handler)}); // jr z
+        sample_timing();
+
+        emit({0x79, 0xC6, 0x25, 0xFE, 0x90}); // ld a, c; add a, 37; cp 144
+        emit({0x38, 0x02, 0xD6, 0x90, 0x4F}); // jr c, +2; sub a, 144; ld c, a
+        emit({0x18, relative(main_loop)});    // jr
+
+        at = 0x0200;
+        emit({0xF5});                                     // push af
+        emit({0xFA, 0x01, 0xC0, 0x3C, 0xEA, 0x01, 0xC0}); // count the overflows at 0xC001
+        emit({0xF1, 0xD9});                               // pop af; reti
+
+        return rom;
+    }
+
+    std::string_view to_string(Machine::ExecutionMode mode)
+    {
+        return mode == Machine::ExecutionMode::m_cycle ? "m_cycle" : "instruction";
+    }
+
+    std::uint64_t hash_frames(Machine& machine, int frames, int state_interval)
+    {
+        std::vector<std::uint8_t> state(state_interval > 0 ? machine.get_state_size() : 0);
+
+        auto hash{initial_hash};
+        for (auto frame{1}; frame <= frames; ++frame) {
+            machine.step_frame();
+            hash = hash_bytes(machine.get_frame(), hash);
+            if (state_interval > 0 && frame % state_interval == 0) {
+                machine.save_state(state);
+                hash = hash_bytes(state, hash);
+            }
+        }
+
+        return hash;
+    }
+
+    std::unique_ptr<Machine> create_machine(const std::string& rom_file, std::span<const std::uint8_t> rom_image, Machine::ExecutionMode mode)
+    {
+        auto cartridge_memory{rom_file.empty() ? cartridge::Storage{.rom{rom_image}} : cartridge::create_storage(rom_file)};
+        cartridge::Banking cartridge_banking{cartridge::create_mbc(std::move(cartridge_memory))};
+        auto p_machine{std::make_unique<Machine>(std::move(cartridge_banking), mode)};
+        p_machine->preboot();
+        return p_machine;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "hash.hpp"
+#include "machine.hpp"
+
+namespace gameboy::test {
+    /*
+        A 64 KiB MBC1 cartridge which keeps every component busy, so that no ROM file is needed
+        to run the tests. It fills the VRAM and the OAM with pseudo-random data, shows the
+        background, the window and the sprites, scrolls at every V-Blank, moves the window from
+        the timer interrupt in the middle of the frames, writes the sound registers, and calls into
+        the 3 switchable banks in turn between HALTs.
+
+        With raster effects, an LCD STAT interrupt at the start of every line also writes the OAM,
+        then SCX, BGP and the tile map after a delay which depends on LY, so that the writes land
+        all over the pixel transfer.
+    */
+    std::vector<std::uint8_t> build_busy_rom(bool has_raster_effects = false);
+
+    /*
+        A 32 KiB cartridge which spends most of its time halted. It sleeps with IME on, then with IME
+        off, and is woken up by the V-Blank, the LYC coincidence, which moves every time, the timer
+        and the serial port. The timer stops every other frame, and the PSG is turned off for two
+        frames out of four. The handlers sample TIMA and STAT, which shows when they have run.
+    */
+    std::vector<std::uint8_t> build_halt_rom();
+
+    /*
+        A 32 KiB cartridge which spends most of its time in idle loops: it waits for LY to reach the
+        V-Blank and then a line which moves every time, for STAT to report the H-Blank and then the
+        pixel transfer, for IF to flag the timer with IME off, and for the timer interrupt to change
+        the work RAM. After each wait, it mixes TIMA (counting every 4 m-cycles) and DIV into the
+        work RAM, which shows when the loop has been left.
+    */
+    std::vector<std::uint8_t> build_polling_rom();
+
+    std::string_view to_string(Machine::ExecutionMode mode);
+
+    // Chain the hashes of the frames, and of the save states every given number of frames if any.
+    std::uint64_t hash_frames(Machine& machine, int frames, int state_interval = 0);
+
+    // A machine past the boot process, running the ROM file or else the image, which has to outlive it.
+    std::unique_ptr<Machine> create_machine(const std::string& rom_file, std::span<const std::uint8_t> rom_image, Machine::ExecutionMode mode);
+}
+
+#endif
\ No newline at end of file
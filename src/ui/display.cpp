@@ -21,7 +21,7 @@ namespace gameboy::ui {
     RendererPtr create_renderer(WindowPtr& window, Scale horizontal, Scale vertical)
     {
         RendererPtr p_renderer{
-            SDL_CreateRenderer(window.get(), -1, SDL_RENDERER_ACCELERATED),
+            SDL_CreateRenderer(window.get(), -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC),
             [](SDL_Renderer* ptr) { SDL_DestroyRenderer(ptr); }
         };
 
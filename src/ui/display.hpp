@@ -1,8 +1,10 @@
 #ifndef UI_DISPLAY_H
 #define UI_DISPLAY_H
 
+#include <cstdint>
 #include <memory>
-#include <vector>
+#include <span>
+#include <string_view>
 #include "SDL.h"
 
 namespace gameboy::ui {
@@ -26,12 +28,12 @@ namespace gameboy::ui {
     RendererPtr create_renderer(WindowPtr& window, Scale horizontal, Scale vertical);
     TexturePtr create_texture(RendererPtr& renderer, Width width, Height height);
 
-    template<int W, int H, int BytesPerPixel = 4>
-    void render(SDL_Renderer& renderer, SDL_Texture& texture, const std::vector<std::uint8_t>& buffer)
+    template<int BytesPerPixel = 4>
+    void render(SDL_Renderer& renderer, SDL_Texture& texture, std::span<const std::uint8_t> buffer, Width width)
     {
         SDL_SetRenderDrawColor(&renderer, 0xFF, 0xFF, 0xFF, 0xFF);
         SDL_RenderClear(&renderer);
-        SDL_UpdateTexture(&texture, nullptr, buffer.data(), W * BytesPerPixel);
+        SDL_UpdateTexture(&texture, nullptr, buffer.data(), width.value * BytesPerPixel);
         SDL_RenderCopy(&renderer, &texture, nullptr, nullptr);
         SDL_RenderPresent(&renderer);
     }
@@ -0,0 +1,39 @@
+#include "mailbox.hpp"
+#include <algorithm>
+
+namespace gameboy::ui {
+    FrameMailbox::FrameMailbox(std::size_t frame_size)
+    {
+        for (auto& slot : slots) {
+            slot.resize(frame_size);
+        }
+    }
+
+    void FrameMailbox::post(std::span<const std::uint8_t> frame)
+    {
+        auto& slot{slots[producer_slot]};
+        std::copy_n(frame.begin(), std::min(frame.size(), slot.size()), slot.begin());
+
+        auto previous{shared_slot.exchange(producer_slot | fresh_flag, std::memory_order_acq_rel)};
+        if ((previous & fresh_flag) != 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        producer_slot = previous & ~fresh_flag;
+    }
+
+    std::optional<std::span<const std::uint8_t>> FrameMailbox::take()
+    {
+        if ((shared_slot.load(std::memory_order_relaxed) & fresh_flag) == 0) {
+            return std::nullopt;
+        }
+
+        consumer_slot = shared_slot.exchange(consumer_slot, std::memory_order_acq_rel) & ~fresh_flag;
+        return slots[consumer_slot];
+    }
+
+    std::uint64_t FrameMailbox::get_dropped_count() const
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef UI_MAILBOX_H
+#define UI_MAILBOX_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace gameboy::ui {
+    /*
+        Hands the latest frame from one producer thread over to one consumer thread without a lock.
+        Each side owns a slot and swaps it with the shared one, so a slot is never written while
+        it's being read. A frame which hasn't been taken by the time the next one is posted is dropped.
+    */
+    class FrameMailbox {
+    public:
+        explicit FrameMailbox(std::size_t frame_size);
+
+        void post(std::span<const std::uint8_t> frame);
+        std::optional<std::span<const std::uint8_t>> take(); // valid until the next call
+        std::uint64_t get_dropped_count() const;
+    private:
+        static constexpr int fresh_flag{0b100}; // set along with the shared slot index until it's taken
+
+        std::array<std::vector<std::uint8_t>, 3> slots{};
+        int producer_slot{0};
+        int consumer_slot{1};
+        std::atomic<int> shared_slot{2};
+        std::atomic<std::uint64_t> dropped{0};
+    };
+}
+
+#endif
\ No newline at end of file
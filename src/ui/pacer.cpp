@@ -0,0 +1,87 @@
+#include "pacer.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace gameboy::ui {
+    using namespace std::chrono_literals;
+
+    constexpr auto min_spin_tail{200us};
+    constexpr auto max_spin_tail{4ms};
+    constexpr int max_frames_behind{4};
+
+    FramePacer::FramePacer(Clock::duration period, double multiplier)
+        : frame_period{period}
+        , target_period{period}
+        , speed{}
+        , deadline{Clock::now()}
+    {
+        set_speed(multiplier);
+    }
+
+    void FramePacer::wait()
+    {
+        if (speed == unbounded) {
+            return;
+        }
+
+        deadline += target_period;
+
+        if (auto wake_time{deadline - spin_tail}; Clock::now() < wake_time) {
+            std::this_thread::sleep_until(wake_time);
+
+            // Widen the tail at once when the sleep overshoots, and narrow it again slowly.
+            auto overshoot{Clock::now() - wake_time};
+            auto tail{std::max(overshoot + overshoot / 2, spin_tail - spin_tail / 16)};
+            spin_tail = std::clamp<Clock::duration>(tail, min_spin_tail, max_spin_tail);
+        }
+
+        auto now{Clock::now()};
+        while (now < deadline) {
+            now = Clock::now();
+        }
+
+        auto drift{now - deadline};
+        total_drift += drift;
+        ++frames;
+
+        // Running the missed frames back to back would only look like a glitch, so start over.
+        if (drift > target_period * max_frames_behind) {
+            resync(now);
+            ++resyncs;
+        }
+    }
+
+    void FramePacer::set_speed(double multiplier)
+    {
+        speed = std::max(multiplier, unbounded);
+        if (speed != unbounded) {
+            target_period = std::chrono::duration_cast<Clock::duration>(frame_period / speed);
+        }
+
+        resync(Clock::now());
+    }
+
+    double FramePacer::get_speed() const
+    {
+        return speed;
+    }
+
+    FramePacer::Clock::duration FramePacer::get_average_drift() const
+    {
+        if (frames == 0) {
+            return {};
+        }
+
+        return total_drift / static_cast<Clock::rep>(frames);
+    }
+
+    std::uint64_t FramePacer::get_resync_count() const
+    {
+        return resyncs;
+    }
+
+    void FramePacer::resync(Clock::time_point now)
+    {
+        deadline = now;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef UI_PACER_H
+#define UI_PACER_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace gameboy::ui {
+    /*
+        Keeps the emulation at a steady frame rate without burning a core. The thread sleeps until
+        shortly before the next deadline and only spins for the rest, since the OS may wake it late.
+        The deadlines are fixed on a grid, so the error of one frame doesn't carry over to the next.
+    */
+    class FramePacer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr double unbounded{0.0};
+
+        explicit FramePacer(Clock::duration period, double speed = 1.0);
+
+        void wait(); // return when the next frame is due
+        void set_speed(double multiplier);
+        double get_speed() const;
+        Clock::duration get_average_drift() const; // how late the frames were on average
+        std::uint64_t get_resync_count() const;    // how many times the schedule was given up for being too far behind
+    private:
+        void resync(Clock::time_point now);
+
+        Clock::duration frame_period;
+        Clock::duration target_period;
+        double speed;
+        Clock::time_point deadline;
+        Clock::duration spin_tail{std::chrono::milliseconds{1}};
+
+        Clock::duration total_drift{};
+        std::uint64_t frames{};
+        std::uint64_t resyncs{};
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "presenter.hpp"
+
+namespace gameboy::ui {
+    Presenter::Presenter(WindowPtr& window, Width width, Height height, Scale scale)
+        : frame_width{width}
+        , mailbox{static_cast<std::size_t>(width.value * height.value * 4)}
+        , p_renderer{create_renderer(window, scale, scale)}
+        , p_texture{create_texture(p_renderer, width, height)}
+    {
+        SDL_RendererInfo info{};
+        SDL_GetRendererInfo(p_renderer.get(), &info);
+        is_synchronized = (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+    }
+
+    void Presenter::post(std::span<const std::uint8_t> frame)
+    {
+        mailbox.post(frame);
+    }
+
+    bool Presenter::present()
+    {
+        if (auto frame{mailbox.take()}; frame.has_value()) {
+            shown_frame = *frame;
+            render(*p_renderer, *p_texture, shown_frame, frame_width);
+            ++presented;
+            return true;
+        }
+
+        if (is_synchronized && !shown_frame.empty()) {
+            // Presenting blocks until the next refresh, which shows the same frame again.
+            render(*p_renderer, *p_texture, shown_frame, frame_width);
+            ++duplicated;
+            return true;
+        }
+
+        return false;
+    }
+
+    std::uint64_t Presenter::get_presented_count() const
+    {
+        return presented;
+    }
+
+    std::uint64_t Presenter::get_dropped_count() const
+    {
+        return mailbox.get_dropped_count();
+    }
+
+    std::uint64_t Presenter::get_duplicated_count() const
+    {
+        return duplicated;
+    }
+}
\ No newline at end of file
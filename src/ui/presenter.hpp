@@ -0,0 +1,39 @@
+#ifndef UI_PRESENTER_H
+#define UI_PRESENTER_H
+
+#include <cstdint>
+#include <span>
+#include "display.hpp"
+#include "mailbox.hpp"
+
+namespace gameboy::ui {
+    /*
+        Shows the frames posted by the emulating thread. The renderer and the texture belong to the
+        thread which creates the presenter, and present() must be called there: SDL expects the window
+        and its renderer to stay on the main thread. Waiting for the display (with V-Sync) happens in
+        present() only, so it never holds the emulation up.
+    */
+    class Presenter {
+    public:
+        Presenter(WindowPtr& window, Width width, Height height, Scale scale);
+        Presenter(const Presenter&) = delete;
+        Presenter& operator=(const Presenter&) = delete;
+
+        void post(std::span<const std::uint8_t> frame); // from the emulating thread
+        bool present(); // whether a frame has been shown, which waits for the next refresh with V-Sync
+        std::uint64_t get_presented_count() const;
+        std::uint64_t get_dropped_count() const;    // replaced by a newer frame before being shown
+        std::uint64_t get_duplicated_count() const; // shown again because no new frame was ready
+    private:
+        Width frame_width;
+        FrameMailbox mailbox;
+        RendererPtr p_renderer;
+        TexturePtr p_texture;
+        bool is_synchronized{false};
+        std::span<const std::uint8_t> shown_frame{};
+        std::uint64_t presented{0};
+        std::uint64_t duplicated{0};
+    };
+}
+
+#endif
\ No newline at end of file
@@ -1,7 +1,7 @@
 #ifndef SOUND_H
 #define SOUND_H
 
-#include <vector>
+#include <span>
 #include "SDL.h"
 
 namespace gameboy::ui {
@@ -15,7 +15,7 @@ namespace gameboy::ui {
     };
 
     template<int BytesPerSample = 4>
-    void play_sound(SDL_AudioDeviceID id, const std::vector<float>& buffer)
+    void play_sound(SDL_AudioDeviceID id, std::span<const float> buffer)
     {
         SDL_QueueAudio(id, buffer.data(), static_cast<unsigned int>(buffer.size() * 4));
     }